@@ -8,6 +8,7 @@
  */
 
 #include "Def.hpp"
+#include <unordered_map>
 
 /**
  * @brief Mapping of primitive function names to expression types
@@ -34,6 +35,8 @@ std::map<std::string, ExprType> primitives = {
     {"quotient", E_QUOTIENT},
     {"modulo",   E_MODULO},
     {"expt",     E_EXPT},
+    {"exact->inexact", E_EXACT_TO_INEXACT},
+    {"inexact->exact", E_INEXACT_TO_EXACT},
     
     // Comparison operations
     {"<",        E_LT},
@@ -108,3 +111,30 @@ std::map<std::string, ExprType> reserved_words = {
     // Assignment
     {"set!",    E_SET}
 };
+
+// ============================================================================
+// Symbol Table
+// ============================================================================
+
+SymbolEntry::SymbolEntry(const std::string &s) : name(s), primitive(-1), reserved(-1), cell(nullptr) {
+    auto prim = primitives.find(s);
+    if (prim != primitives.end()) primitive = prim->second;
+    auto word = reserved_words.find(s);
+    if (word != reserved_words.end()) reserved = word->second;
+}
+
+/**
+ * @brief Intern a name
+ *
+ * Entries are never freed, so a Sym stays valid for the whole run.
+ */
+Sym intern(const std::string &s) {
+    static std::unordered_map<std::string, Sym> table;
+    auto it = table.find(s);
+    if (it != table.end()) {
+        return it->second;
+    }
+    Sym sym = new SymbolEntry(s);
+    table.emplace(s, sym);
+    return sym;
+}
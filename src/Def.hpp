@@ -10,6 +10,7 @@
  * declarations used throughout the Scheme interpreter implementation.
  */
 
+#include <cstdint>
 #include <string>
 #include <utility>
 #include <vector>
@@ -20,8 +21,14 @@
 struct Syntax;
 struct Expr;
 struct Value;
-struct AssocList;
+struct ValueBase;
+struct Frame;
 struct Assoc;
+struct Scope;
+struct GlobalCell;
+struct Code;
+struct Callable;
+class Writer;
 
 /**
  * @brief Expression types enumeration
@@ -48,6 +55,7 @@ enum ExprType {
     E_TRUE,             ///< Boolean true literal
     E_FALSE,            ///< Boolean false literal
     E_QUOTE,            ///< Quote expression
+    E_CONST,            ///< Constant computed at parse time
     E_VOID,             ///< Void value
     
     // Arithmetic operations
@@ -58,6 +66,8 @@ enum ExprType {
     E_QUOTIENT,         ///< Integer division
     E_MODULO,           ///< Modulo operation
     E_EXPT,             ///< Exponentiation
+    E_EXACT_TO_INEXACT, ///< Conversion to a flonum
+    E_INEXACT_TO_EXACT, ///< Conversion to an exact number
     
     // Comparison operations
     E_LT,               ///< Less than
@@ -102,7 +112,9 @@ enum ExprType {
  */
 enum ValueType {
     V_INT,              ///< Integer value
-    V_RATIONAL,         ///< Rational number (currently unused)
+    V_BIGNUM,           ///< Integer outside the fixnum range
+    V_RATIONAL,         ///< Rational number in lowest terms
+    V_FLONUM,           ///< Inexact real, an IEEE-754 double
     V_BOOL,             ///< Boolean value
     V_SYM,              ///< Symbol value
     V_NULL,             ///< Null/empty list
@@ -111,7 +123,81 @@ enum ValueType {
     V_PROC,             ///< Procedure/function
     V_VOID,             ///< Void value
     V_PRIMITIVE,        ///< Built-in primitive function
-    V_TERMINATE         ///< Termination signal
+    V_TERMINATE,        ///< Termination signal
+    V_TAILCALL          ///< Pending tail call, never visible to programs
 };
 
+/**
+ * @brief Tagged value word
+ *
+ * Small values are encoded directly in the word and never touch the heap:
+ * - bits & 1 == 1: fixnum, the integer is stored in the upper bits
+ * - bits & 3 == 2: immediate constant (#f, #t, (), void, terminate, tail call)
+ * - otherwise: pointer to a collected ValueBase, 0 meaning unbound
+ *
+ * Copying a Value is a plain word copy; liveness is decided by the collector.
+ */
+struct Value {
+    uintptr_t bits;
+    Value(ValueBase *);
+    ValueType type() const;
+    bool isHeap() const;
+    bool isUnbound() const;
+    int fixnum() const;
+    bool boolean() const;
+    void show(Writer &) const;
+    ValueBase* operator->() const;
+    ValueBase& operator*();
+    ValueBase* get() const;
+    bool operator==(const Value &) const;
+    bool operator!=(const Value &) const;
+    template <class T> T *as() const;   ///< Checked downcast, nullptr if not a T
+    static Value fromBits(uintptr_t);
+};
+
+/**
+ * @brief Syntax types enumeration
+ *
+ * Defines the kinds of syntax objects produced by the reader.
+ */
+enum SyntaxType {
+    S_NUMBER,           ///< Integer literal
+    S_BIGNUM,           ///< Integer literal outside the fixnum range
+    S_FLONUM,           ///< Decimal literal
+    S_TRUE,             ///< #t
+    S_FALSE,            ///< #f
+    S_SYMBOL,           ///< Identifier
+    S_STRING,           ///< String literal
+    S_LIST              ///< Parenthesized list
+};
+
+// Names of the primitive procedures and of the reserved words (Def.cpp)
+extern std::map<std::string, ExprType> primitives;
+extern std::map<std::string, ExprType> reserved_words;
+
+/**
+ * @brief Entry of the global symbol table
+ *
+ * Every distinct identifier is interned exactly once, so identifiers are
+ * compared by pointer everywhere after the reader. The entry also caches
+ * what the name means to the parser and the global cell bound to it.
+ */
+struct SymbolEntry {
+    std::string name;       ///< Identifier text
+    int primitive;          ///< ExprType of the primitive with this name, or -1
+    int reserved;           ///< ExprType of the reserved word with this name, or -1
+    GlobalCell *cell;       ///< Global variable cell, created on first use
+    SymbolEntry(const std::string &);
+};
+
+/**
+ * @brief Interned identifier
+ */
+typedef SymbolEntry *Sym;
+
+/**
+ * @brief Look up the unique symbol for a name, creating it if necessary
+ */
+Sym intern(const std::string &);
+
 #endif // DEF_HPP
@@ -0,0 +1,362 @@
+/**
+ * @file bigint.cpp
+ * @brief Arbitrary-precision signed integers
+ *
+ * All the work is done on magnitudes; the signed operations only decide
+ * which magnitude operation to run and the sign of its result.
+ */
+
+#include "bigint.hpp"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+typedef std::vector<uint32_t> Mag;
+
+namespace {
+
+// 去掉高位的 0，保证表示唯一
+void trim(Mag &a) {
+    while (!a.empty() && a.back() == 0) a.pop_back();
+}
+
+int compareMag(const Mag &a, const Mag &b) {
+    if (a.size() != b.size()) return a.size() < b.size() ? -1 : 1;
+    for (size_t i = a.size(); i-- > 0;) {
+        if (a[i] != b[i]) return a[i] < b[i] ? -1 : 1;
+    }
+    return 0;
+}
+
+Mag addMag(const Mag &a, const Mag &b) {
+    const Mag &x = a.size() >= b.size() ? a : b;
+    const Mag &y = a.size() >= b.size() ? b : a;
+    Mag r(x.size() + 1);
+    uint64_t carry = 0;
+    for (size_t i = 0; i < x.size(); i++) {
+        uint64_t t = uint64_t(x[i]) + (i < y.size() ? y[i] : 0) + carry;
+        r[i] = uint32_t(t);
+        carry = t >> 32;
+    }
+    r[x.size()] = uint32_t(carry);
+    trim(r);
+    return r;
+}
+
+// 要求 a >= b
+Mag subMag(const Mag &a, const Mag &b) {
+    Mag r(a.size());
+    int64_t borrow = 0;
+    for (size_t i = 0; i < a.size(); i++) {
+        int64_t t = int64_t(a[i]) - (i < b.size() ? b[i] : 0) - borrow;
+        borrow = t < 0;
+        r[i] = uint32_t(t + (borrow << 32));
+    }
+    trim(r);
+    return r;
+}
+
+Mag mulMag(const Mag &a, const Mag &b) {
+    if (a.empty() || b.empty()) return Mag();
+    Mag r(a.size() + b.size());
+    for (size_t i = 0; i < a.size(); i++) {
+        uint64_t carry = 0;
+        uint64_t ai = a[i];
+        for (size_t j = 0; j < b.size(); j++) {
+            uint64_t t = ai * b[j] + r[i + j] + carry;
+            r[i + j] = uint32_t(t);
+            carry = t >> 32;
+        }
+        r[i + b.size()] = uint32_t(carry);
+    }
+    trim(r);
+    return r;
+}
+
+// a = a * m + c，用于十进制解析
+void mulAddSmall(Mag &a, uint32_t m, uint32_t c) {
+    uint64_t carry = c;
+    for (size_t i = 0; i < a.size(); i++) {
+        uint64_t t = uint64_t(a[i]) * m + carry;
+        a[i] = uint32_t(t);
+        carry = t >> 32;
+    }
+    if (carry) a.push_back(uint32_t(carry));
+}
+
+// a = a / d，返回余数
+uint32_t divSmall(Mag &a, uint32_t d) {
+    uint64_t rem = 0;
+    for (size_t i = a.size(); i-- > 0;) {
+        uint64_t cur = (rem << 32) | a[i];
+        a[i] = uint32_t(cur / d);
+        rem = cur % d;
+    }
+    trim(a);
+    return uint32_t(rem);
+}
+
+int leadingZeros(uint32_t x) {
+    int n = 0;
+    while (!(x & 0x80000000u)) {
+        x <<= 1;
+        n++;
+    }
+    return n;
+}
+
+/**
+ * Long division of magnitudes (Knuth, TAOCP vol. 2, 4.3.1, Algorithm D).
+ * The divisor is normalized so its top limb has the high bit set, which
+ * keeps every estimated quotient digit at most two too large.
+ */
+void divmodMag(const Mag &u, const Mag &v, Mag &q, Mag &r) {
+    if (compareMag(u, v) < 0) {
+        q.clear();
+        r = u;
+        return;
+    }
+    if (v.size() == 1) {
+        q = u;
+        uint32_t rem = divSmall(q, v[0]);
+        r.clear();
+        if (rem) r.push_back(rem);
+        return;
+    }
+    size_t n = v.size(), m = u.size() - n;
+    int s = leadingZeros(v[n - 1]);
+    Mag vn(n), un(u.size() + 1);
+    for (size_t i = n; i-- > 0;) {
+        vn[i] = (v[i] << s) | (s && i ? v[i - 1] >> (32 - s) : 0);
+    }
+    un[u.size()] = s ? u[u.size() - 1] >> (32 - s) : 0;
+    for (size_t i = u.size(); i-- > 0;) {
+        un[i] = (u[i] << s) | (s && i ? u[i - 1] >> (32 - s) : 0);
+    }
+    const uint64_t base = uint64_t(1) << 32;
+    q.assign(m + 1, 0);
+    for (size_t j = m + 1; j-- > 0;) {
+        uint64_t num = (uint64_t(un[j + n]) << 32) | un[j + n - 1];
+        uint64_t qhat = num / vn[n - 1];
+        uint64_t rhat = num % vn[n - 1];
+        while (qhat >= base || qhat * vn[n - 2] > ((rhat << 32) | un[j + n - 2])) {
+            qhat--;
+            rhat += vn[n - 1];
+            if (rhat >= base) break;
+        }
+        // un[j..j+n] -= qhat * vn
+        int64_t borrow = 0;
+        uint64_t carry = 0;
+        for (size_t i = 0; i < n; i++) {
+            uint64_t p = qhat * vn[i] + carry;
+            carry = p >> 32;
+            int64_t t = int64_t(un[i + j]) - int64_t(uint32_t(p)) - borrow;
+            borrow = t < 0;
+            un[i + j] = uint32_t(t + (borrow << 32));
+        }
+        int64_t t = int64_t(un[j + n]) - int64_t(carry) - borrow;
+        un[j + n] = uint32_t(t);
+        if (t < 0) {
+            // 估计值大了 1，加回一个除数
+            qhat--;
+            uint64_t c = 0;
+            for (size_t i = 0; i < n; i++) {
+                uint64_t sum = uint64_t(un[i + j]) + vn[i] + c;
+                un[i + j] = uint32_t(sum);
+                c = sum >> 32;
+            }
+            un[j + n] += uint32_t(c);
+        }
+        q[j] = uint32_t(qhat);
+    }
+    trim(q);
+    r.assign(n, 0);
+    for (size_t i = 0; i < n; i++) {
+        r[i] = (un[i] >> s) | (s ? uint32_t(uint64_t(un[i + 1]) << (32 - s)) : 0);
+    }
+    trim(r);
+}
+
+BigInt make(bool neg, const Mag &mag) {
+    BigInt r;
+    r.mag = mag;
+    r.neg = neg && !mag.empty();
+    return r;
+}
+
+} // namespace
+
+BigInt::BigInt() : neg(false) {}
+
+BigInt::BigInt(long long v) : neg(v < 0) {
+    unsigned long long m = neg ? 0ULL - (unsigned long long)v : (unsigned long long)v;
+    while (m) {
+        mag.push_back(uint32_t(m));
+        m >>= 32;
+    }
+}
+
+bool BigInt::isZero() const {
+    return mag.empty();
+}
+
+int BigInt::sign() const {
+    return mag.empty() ? 0 : neg ? -1 : 1;
+}
+
+bool BigInt::fitsLong() const {
+    if (mag.size() > 2) return false;
+    uint64_t m = mag.empty() ? 0 : mag.size() == 1 ? mag[0] : (uint64_t(mag[1]) << 32) | mag[0];
+    return neg ? m <= uint64_t(LLONG_MAX) + 1 : m <= uint64_t(LLONG_MAX);
+}
+
+long long BigInt::toLong() const {
+    uint64_t m = mag.empty() ? 0 : mag.size() == 1 ? mag[0] : (uint64_t(mag[1]) << 32) | mag[0];
+    return neg ? (long long)(0 - m) : (long long)m;
+}
+
+bool BigInt::fitsInt() const {
+    if (mag.size() > 1) return false;
+    uint64_t m = mag.empty() ? 0 : mag[0];
+    return neg ? m <= uint64_t(INT_MAX) + 1 : m <= uint64_t(INT_MAX);
+}
+
+int BigInt::toInt() const {
+    return int(toLong());
+}
+
+int BigInt::bitLength() const {
+    if (mag.empty()) return 0;
+    return int(mag.size()) * 32 - leadingZeros(mag.back());
+}
+
+double BigInt::toDouble() const {
+    int bits = bitLength();
+    if (bits <= 64) {
+        uint64_t m = mag.empty() ? 0 : mag.size() == 1 ? mag[0] : (uint64_t(mag[1]) << 32) | mag[0];
+        double d = double(m);
+        return neg ? -d : d;
+    }
+    // 保留最高的 64 位，截掉的位中有 1 时置最低位（粘滞位），使舍入只发生一次
+    int shift = bits - 64;
+    BigInt top = *this >> shift;
+    uint64_t m = (uint64_t(top.mag[1]) << 32) | top.mag[0];
+    bool sticky = false;
+    for (int i = 0; i < shift / 32 && !sticky; i++) sticky = mag[i] != 0;
+    if (shift % 32 && (mag[shift / 32] & ((1u << (shift % 32)) - 1))) sticky = true;
+    if (sticky) m |= 1;
+    double d = std::ldexp(double(m), shift);
+    return neg ? -d : d;
+}
+
+std::string BigInt::toString() const {
+    if (mag.empty()) return "0";
+    // 每次除以 10^9，得到从低到高的 9 位十进制块
+    Mag m = mag;
+    std::vector<uint32_t> chunks;
+    while (!m.empty()) chunks.push_back(divSmall(m, 1000000000u));
+    std::string s = neg ? "-" : "";
+    s += std::to_string(chunks.back());
+    for (size_t i = chunks.size() - 1; i-- > 0;) {
+        std::string digits = std::to_string(chunks[i]);
+        s.append(9 - digits.size(), '0');
+        s += digits;
+    }
+    return s;
+}
+
+BigInt BigInt::operator-() const {
+    return make(!neg, mag);
+}
+
+bool parseBigInt(const std::string &s, BigInt &result) {
+    size_t i = 0;
+    bool neg = false;
+    if (i < s.size() && (s[i] == '+' || s[i] == '-')) {
+        neg = s[i] == '-';
+        i++;
+    }
+    if (i == s.size()) return false;
+    for (size_t j = i; j < s.size(); j++) {
+        if (s[j] < '0' || s[j] > '9') return false;
+    }
+    Mag m;
+    // 第一块取余下的位数，其后每块 9 位
+    size_t first = (s.size() - i) % 9;
+    if (first == 0) first = 9;
+    while (i < s.size()) {
+        uint32_t chunk = 0, scale = 1;
+        for (size_t end = i + first; i < end; i++) {
+            chunk = chunk * 10 + (s[i] - '0');
+            scale *= 10;
+        }
+        mulAddSmall(m, scale, chunk);
+        first = 9;
+    }
+    trim(m);
+    result = make(neg, m);
+    return true;
+}
+
+int compare(const BigInt &a, const BigInt &b) {
+    if (a.neg != b.neg) return a.neg ? -1 : 1;
+    int c = compareMag(a.mag, b.mag);
+    return a.neg ? -c : c;
+}
+
+BigInt operator+(const BigInt &a, const BigInt &b) {
+    if (a.neg == b.neg) return make(a.neg, addMag(a.mag, b.mag));
+    // 异号：大的绝对值减去小的，符号随绝对值大的一方
+    if (compareMag(a.mag, b.mag) >= 0) return make(a.neg, subMag(a.mag, b.mag));
+    return make(b.neg, subMag(b.mag, a.mag));
+}
+
+BigInt operator-(const BigInt &a, const BigInt &b) {
+    return a + (-b);
+}
+
+BigInt operator*(const BigInt &a, const BigInt &b) {
+    return make(a.neg != b.neg, mulMag(a.mag, b.mag));
+}
+
+BigInt operator<<(const BigInt &a, int n) {
+    if (a.mag.empty() || n == 0) return a;
+    int limbs = n / 32, bits = n % 32;
+    Mag r(a.mag.size() + limbs + 1, 0);
+    for (size_t i = 0; i < a.mag.size(); i++) {
+        r[i + limbs] |= a.mag[i] << bits;
+        if (bits) r[i + limbs + 1] = a.mag[i] >> (32 - bits);
+    }
+    trim(r);
+    return make(a.neg, r);
+}
+
+BigInt operator>>(const BigInt &a, int n) {
+    size_t limbs = n / 32;
+    int bits = n % 32;
+    if (limbs >= a.mag.size()) return BigInt();
+    Mag r(a.mag.size() - limbs);
+    for (size_t i = 0; i < r.size(); i++) {
+        r[i] = a.mag[i + limbs] >> bits;
+        if (bits && i + limbs + 1 < a.mag.size()) r[i] |= a.mag[i + limbs + 1] << (32 - bits);
+    }
+    trim(r);
+    return make(a.neg, r);
+}
+
+void divmod(const BigInt &a, const BigInt &b, BigInt &q, BigInt &r) {
+    Mag qm, rm;
+    divmodMag(a.mag, b.mag, qm, rm);
+    q = make(a.neg != b.neg, qm);
+    r = make(a.neg, rm);
+}
+
+BigInt gcd(const BigInt &a, const BigInt &b) {
+    Mag x = a.mag, y = b.mag, q, r;
+    while (!y.empty()) {
+        divmodMag(x, y, q, r);
+        x.swap(y);
+        y.swap(r);
+    }
+    return make(false, x);
+}
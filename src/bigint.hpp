@@ -0,0 +1,57 @@
+#ifndef BIGINT_HPP
+#define BIGINT_HPP
+
+/**
+ * @file bigint.hpp
+ * @brief Arbitrary-precision signed integers
+ *
+ * Sign-magnitude representation with 32-bit limbs, least significant first.
+ * The magnitude never has leading zero limbs and zero is the empty
+ * magnitude, so every integer has exactly one representation.
+ */
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct BigInt {
+    bool neg;                       ///< Sign, false for zero
+    std::vector<uint32_t> mag;      ///< Magnitude, least significant limb first
+
+    BigInt();
+    BigInt(long long);
+
+    bool isZero() const;
+    int sign() const;               ///< -1, 0 or 1
+    bool fitsInt() const;
+    int toInt() const;              ///< Only valid when fitsInt()
+    bool fitsLong() const;
+    long long toLong() const;       ///< Only valid when fitsLong()
+    int bitLength() const;          ///< Bits in the magnitude, 0 for zero
+    double toDouble() const;        ///< Correctly rounded, infinite when out of range
+    std::string toString() const;
+
+    BigInt operator-() const;
+};
+
+/**
+ * @brief Parse an optionally signed decimal integer, false if s is not one
+ */
+bool parseBigInt(const std::string &, BigInt &);
+
+int compare(const BigInt &, const BigInt &);
+BigInt operator+(const BigInt &, const BigInt &);
+BigInt operator-(const BigInt &, const BigInt &);
+BigInt operator*(const BigInt &, const BigInt &);
+BigInt operator<<(const BigInt &, int);
+BigInt operator>>(const BigInt &, int);       ///< Shifts the magnitude, rounding toward zero
+
+/**
+ * @brief Truncating division: the quotient rounds toward zero and the
+ * remainder has the sign of the dividend
+ */
+void divmod(const BigInt &, const BigInt &, BigInt &, BigInt &);
+
+BigInt gcd(const BigInt &, const BigInt &);
+
+#endif // BIGINT_HPP
@@ -0,0 +1,116 @@
+#ifndef BYTECODE_HPP
+#define BYTECODE_HPP
+
+/**
+ * @file bytecode.hpp
+ * @brief Bytecode compiler and stack-based virtual machine
+ *
+ * The Expr tree produced by the parser is compiled into a linear stream of
+ * 32-bit words (an opcode followed by its operands) and run by a loop with
+ * an operand stack and an explicit stack of call frames. Environments,
+ * closures and values are shared with the tree walker, which remains
+ * available as a reference engine.
+ *
+ * Every construct behaves exactly as its ExprBase::eval: rare or
+ * error-reporting paths fall back to the corresponding node, which each
+ * Code keeps in its exprs table.
+ */
+
+#include "Def.hpp"
+#include "gc.hpp"
+#include "value.hpp"
+#include "expr.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Instruction set, with the operands each opcode is followed by
+ *
+ * Jump offsets are relative to the word after the operand.
+ */
+#define BYTECODE_OPS(X) \
+    X(OP_FIXNUM)        /* n: push the fixnum n */ \
+    X(OP_CONST)         /* k: push consts[k] */ \
+    X(OP_STACK)         /* off v: push the stack slot fp[off]; Var exprs[v] if unbound */ \
+    X(OP_LOCAL0)        /* i v: push slot i of the current frame */ \
+    X(OP_LOCAL1)        /* i v: push slot i of the parent frame */ \
+    X(OP_LOCAL)         /* d i v: push slot i of the frame d levels up */ \
+    X(OP_GLOBAL)        /* c v: push cells[c] */ \
+    X(OP_EVAL)          /* k: push exprs[k]->eval(env) (tree walker fallback) */ \
+    X(OP_POP)           /* discard the top value */ \
+    X(OP_SWAP)          /* exchange the top two values */ \
+    X(OP_SLIDE)         /* n: drop the n values below the top */ \
+    X(OP_JUMP)          /* off */ \
+    X(OP_JFALSE)        /* off: pop, jump if #f */ \
+    X(OP_JFALSE_KEEP)   /* off: jump if the top is #f, else pop */ \
+    X(OP_JTRUE_KEEP)    /* off: jump if the top is not #f, else pop */ \
+    X(OP_CLOSURE)       /* e c: closure of Lambda exprs[e] with body codes[c] */ \
+    X(OP_PUSH_FRAME)    /* n: enter a frame of n unbound slots */ \
+    X(OP_BIND_FRAME)    /* n: enter a frame holding the top n values */ \
+    X(OP_FILL_FRAME)    /* n: pop n values into the current frame */ \
+    X(OP_POP_FRAME)     /* leave the current frame */ \
+    X(OP_PUSH_UNBOUND)  /* n: push n unbound stack slots */ \
+    X(OP_FILL_STACK)    /* off n: pop n values into fp[off..] */ \
+    X(OP_STORE_STACK)   /* off: store the top into fp[off], replace it by void */ \
+    X(OP_STORE_LOCAL)   /* d i: store the top into a slot, replace it by void */ \
+    X(OP_STORE_GLOBAL)  /* c: store the top into cells[c], replace it by void */ \
+    X(OP_SET_CHECK_STACK) /* k off: the variable of Set exprs[k] must be bound */ \
+    X(OP_SET_CHECK)     /* k d i: same for a frame slot, or the global when d < 0 */ \
+    X(OP_CHECK_PROC)    /* the top must be a procedure */ \
+    X(OP_CALL)          /* n: call the procedure below the top n arguments */ \
+    X(OP_TAIL_CALL)     /* n: same, reusing the current call frame */ \
+    X(OP_RETURN)        /* return the top to the caller */ \
+    X(OP_ADD)           /* k: fixnum fast paths, exprs[k] otherwise */ \
+    X(OP_SUB)           /* k */ \
+    X(OP_MUL)           /* k */ \
+    X(OP_LT)            /* k */ \
+    X(OP_LE)            /* k */ \
+    X(OP_NUM_EQ)        /* k */ \
+    X(OP_GE)            /* k */ \
+    X(OP_GT)            /* k */ \
+    X(OP_EQQ)           /* k */ \
+    X(OP_CONS)          /* k */ \
+    X(OP_BINARY)        /* k: Binary exprs[k] on the top two values */ \
+    X(OP_CAR)           /* k */ \
+    X(OP_CDR)           /* k */ \
+    X(OP_NULLQ)         /* k */ \
+    X(OP_PAIRQ)         /* k */ \
+    X(OP_NOT)           /* k */ \
+    X(OP_UNARY)         /* k: Unary exprs[k] on the top value */ \
+    X(OP_VARIADIC)      /* k n: Variadic exprs[k] on the top n values */
+
+enum Opcode {
+#define BYTECODE_ENUM(op) op,
+    BYTECODE_OPS(BYTECODE_ENUM)
+#undef BYTECODE_ENUM
+    OP_COUNT
+};
+
+/**
+ * @brief Compiled code of one procedure body or top-level expression
+ */
+struct Code : GCObject {
+    std::vector<int32_t> ops;             ///< Instruction stream
+    std::vector<Value> consts;            ///< Constants, literals included
+    std::vector<Expr> exprs;              ///< Nodes consulted at run time
+    std::vector<GlobalCell *> cells;      ///< Global variables referenced
+    std::vector<Code *> codes;            ///< Bodies of nested lambdas
+    bool flat;                            ///< Frames of the body live on the operand stack
+    int max_stack;                        ///< Operand stack words needed above the frame pointer
+    Code();
+    virtual void trace() override;
+};
+
+/**
+ * @brief Compile a procedure body taking the given number of arguments,
+ * or a top-level expression (no arguments)
+ */
+Code *compileCode(const Expr &, int);
+
+/**
+ * @brief Evaluate a top-level expression on the virtual machine
+ */
+Value vmEval(const Expr &, Assoc &);
+
+#endif // BYTECODE_HPP
@@ -0,0 +1,758 @@
+/**
+ * @file closure.cpp
+ * @brief Closure-compilation engine
+ *
+ * Compilation picks, for every node, the function specialized for its shape:
+ * a variable becomes a read at a fixed depth or of a fixed cell, cond becomes
+ * a chain of if/or nodes with the else clause found once, a call to a global
+ * primitive applies it in place, and arithmetic on two fixnums never leaves
+ * the node. Whether a call is in tail position is also decided here.
+ *
+ * Calls run on the C++ stack like the tree walker, with the same trampoline
+ * for tail calls, so the two engines agree on every result and error.
+ */
+
+#include "closure.hpp"
+#include "RE.hpp"
+
+using std::vector;
+
+namespace {
+
+/**
+ * @brief Call prepared by a tail call for the enclosing trampoline
+ *
+ * Only valid between the tail call returning TailCallV() and the trampoline
+ * picking it up; nothing can allocate in between.
+ */
+struct {
+    Value proc = Value(nullptr);
+    Assoc env = Assoc(nullptr);
+} pending_call;
+
+void gcMarkAll(const vector<Callable *> &cs) {
+    for (Callable *c : cs) gcMark(c);
+}
+
+void markCallableRoot(void *p) {
+    gcMark(*static_cast<Callable **>(p));
+}
+
+// ================================================================================
+//                                    NODES
+// ================================================================================
+
+struct ConstNode : Callable {
+    Value v;
+    static Value run(Callable *c, Assoc &) {
+        return static_cast<ConstNode*>(c)->v;
+    }
+    ConstNode(const Value &v) : Callable(&run), v(v) {}
+    virtual void trace() override { gcMark(v); }
+};
+
+// 罕见或必定报错的节点直接交给树遍历求值器
+struct ExprNode : Callable {
+    Expr e;
+    static Value run(Callable *c, Assoc &env) {
+        return static_cast<ExprNode*>(c)->e->eval(env);
+    }
+    ExprNode(const Expr &e) : Callable(&run), e(e) {}
+    virtual void trace() override { gcMark(e); }
+};
+
+struct VarNode : Callable {
+    Expr var;               // 未绑定时由 Var::eval 给出原语或报错
+    int depth;
+    int index;
+    GlobalCell *cell;
+    VarNode(Fn f, const Expr &e) : Callable(f), var(e) {
+        Var *v = static_cast<Var*>(e.get());
+        depth = v->depth;
+        index = v->index;
+        cell = v->global;
+    }
+    virtual void trace() override { gcMark(var); }
+
+    Value checked(const Value &v, Assoc &env) {
+        return v.isUnbound() ? var->eval(env) : v;
+    }
+    static Value runLocal0(Callable *c, Assoc &env) {
+        VarNode *n = static_cast<VarNode*>(c);
+        return n->checked(env->slots()[n->index], env);
+    }
+    static Value runLocal1(Callable *c, Assoc &env) {
+        VarNode *n = static_cast<VarNode*>(c);
+        return n->checked(env->parent->slots()[n->index], env);
+    }
+    static Value runLocal(Callable *c, Assoc &env) {
+        VarNode *n = static_cast<VarNode*>(c);
+        return n->checked(bindingAt(n->depth, n->index, env), env);
+    }
+    static Value runGlobal(Callable *c, Assoc &env) {
+        VarNode *n = static_cast<VarNode*>(c);
+        return n->checked(n->cell->v, env);
+    }
+};
+
+struct LambdaNode : Callable {
+    Expr lambda;
+    Callable *body;
+    static Value run(Callable *c, Assoc &env) {
+        LambdaNode *n = static_cast<LambdaNode*>(c);
+        Lambda *l = static_cast<Lambda*>(n->lambda.get());
+        Value proc = ProcedureV(l->x, l->e, env);
+        static_cast<Procedure*>(proc.get())->compiled = n->body;
+        return proc;
+    }
+    LambdaNode(const Expr &e, Callable *body) : Callable(&run), lambda(e), body(body) {}
+    virtual void trace() override {
+        gcMark(lambda);
+        gcMark(body);
+    }
+};
+
+struct IfNode : Callable {
+    Callable *cond;
+    Callable *conseq;
+    Callable *alter;
+    static Value run(Callable *c, Assoc &env) {
+        IfNode *n = static_cast<IfNode*>(c);
+        checkNativeStack();
+        // 只有 #f 为假
+        return (n->cond->run(env).bits != IMM_FALSE ? n->conseq : n->alter)->run(env);
+    }
+    IfNode(Callable *c, Callable *t, Callable *f) : Callable(&run), cond(c), conseq(t), alter(f) {}
+    virtual void trace() override {
+        gcMark(cond);
+        gcMark(conseq);
+        gcMark(alter);
+    }
+};
+
+/**
+ * @brief Sequence of at least two nodes: begin, bodies of cond clauses,
+ * and/or (which stop early on #f and on a true value respectively)
+ */
+struct SeqNode : Callable {
+    vector<Callable *> es;
+    int frame;              // 先创建的内部定义槽位数，0 表示不创建帧
+    static Value runBegin(Callable *c, Assoc &env) {
+        SeqNode *n = static_cast<SeqNode*>(c);
+        checkNativeStack();
+        size_t last = n->es.size() - 1;
+        for (size_t i = 0; i < last; i++) n->es[i]->run(env);
+        return n->es[last]->run(env);
+    }
+    static Value runBody(Callable *c, Assoc &env) {
+        SeqNode *n = static_cast<SeqNode*>(c);
+        Assoc new_env = extend(n->frame, env);
+        GCRoot root(new_env);
+        return runBegin(c, new_env);
+    }
+    static Value runAnd(Callable *c, Assoc &env) {
+        SeqNode *n = static_cast<SeqNode*>(c);
+        checkNativeStack();
+        size_t last = n->es.size() - 1;
+        for (size_t i = 0; i < last; i++) {
+            if (n->es[i]->run(env).bits == IMM_FALSE) return BooleanV(false);
+        }
+        return n->es[last]->run(env);
+    }
+    static Value runOr(Callable *c, Assoc &env) {
+        SeqNode *n = static_cast<SeqNode*>(c);
+        checkNativeStack();
+        size_t last = n->es.size() - 1;
+        for (size_t i = 0; i < last; i++) {
+            Value v = n->es[i]->run(env);
+            if (v.bits != IMM_FALSE) return v;
+        }
+        return n->es[last]->run(env);
+    }
+    SeqNode(Fn f, const vector<Callable *> &es, int frame = 0) : Callable(f), es(es), frame(frame) {}
+    virtual void trace() override { gcMarkAll(es); }
+};
+
+struct LetNode : Callable {
+    vector<Callable *> inits;
+    Callable *body;
+    static Value runLet(Callable *c, Assoc &env) {
+        LetNode *n = static_cast<LetNode*>(c);
+        checkNativeStack();
+        Assoc cur_env = extend(n->inits.size(), env);
+        GCRoot root(cur_env);
+        Value *slots = cur_env->slots();
+        for (size_t i = 0; i < n->inits.size(); i++) {
+            slots[i] = n->inits[i]->run(env);
+        }
+        return n->body->run(cur_env);
+    }
+    static Value runLetrec(Callable *c, Assoc &env) {
+        LetNode *n = static_cast<LetNode*>(c);
+        checkNativeStack();
+        Assoc env1 = extend(n->inits.size(), env);
+        GCRoot env_root(env1);
+        // 所有初值求值完毕后才写入槽位；只有一个绑定时无需暂存
+        if (n->inits.size() == 1) {
+            Value v = n->inits[0]->run(env1);
+            env1->slots()[0] = v;
+        } else {
+            vector<Value> bindings;
+            GCRoot bindings_root(bindings);
+            for (Callable *init : n->inits) {
+                bindings.push_back(init->run(env1));
+            }
+            Value *slots = env1->slots();
+            for (size_t i = 0; i < bindings.size(); i++) {
+                slots[i] = bindings[i];
+            }
+        }
+        return n->body->run(env1);
+    }
+    LetNode(Fn f, const vector<Callable *> &inits, Callable *body) : Callable(f), inits(inits), body(body) {}
+    virtual void trace() override {
+        gcMarkAll(inits);
+        gcMark(body);
+    }
+};
+
+/**
+ * @brief define and set! of a resolved variable
+ */
+struct StoreNode : Callable {
+    Expr node;              // set! 的变量未绑定时由 Set::eval 报错
+    int depth;
+    int index;
+    GlobalCell *cell;
+    Callable *e;
+    static Value runLocal(Callable *c, Assoc &env) {
+        StoreNode *n = static_cast<StoreNode*>(c);
+        checkNativeStack();
+        Value v = n->e->run(env);
+        bindingAt(n->depth, n->index, env) = v;
+        return VoidV();
+    }
+    static Value runGlobal(Callable *c, Assoc &env) {
+        StoreNode *n = static_cast<StoreNode*>(c);
+        checkNativeStack();
+        n->cell->v = n->e->run(env);
+        return VoidV();
+    }
+    static Value runSet(Callable *c, Assoc &env) {
+        StoreNode *n = static_cast<StoreNode*>(c);
+        checkNativeStack();
+        Value &slot = n->depth >= 0 ? bindingAt(n->depth, n->index, env) : n->cell->v;
+        if (slot.isUnbound()) return n->node->eval(env);
+        slot = n->e->run(env);
+        return VoidV();
+    }
+    StoreNode(Fn f, const Expr &node, int depth, int index, GlobalCell *cell, Callable *e)
+        : Callable(f), node(node), depth(depth), index(index), cell(cell), e(e) {}
+    virtual void trace() override {
+        gcMark(node);
+        gcMark(e);
+    }
+};
+
+struct ApplyNode : Callable {
+    Callable *rator;
+    vector<Callable *> rands;
+    ApplyNode(Fn f, Callable *rator, const vector<Callable *> &rands) : Callable(f), rator(rator), rands(rands) {}
+    virtual void trace() override {
+        gcMark(rator);
+        gcMarkAll(rands);
+    }
+
+    // 原语过程：实参求值后直接调用，不需要帧
+    Value applyPrimitive(Primitive *prim, Assoc &env) {
+        vector<Value> args;
+        GCRoot args_root(args);
+        for (Callable *r : rands) {
+            args.push_back(r->run(env));
+        }
+        return prim->apply(args.data(), args.size());
+    }
+
+    // 检查被调用者并在其闭包环境上建立参数帧（f 和 param_env 由调用者登记为根）
+    Procedure *bind(Value &f, Assoc &param_env, Assoc &env) {
+        Procedure *proc = f.as<Procedure>();
+        if (proc == nullptr) {throw RuntimeError("Attempt to apply a non-procedure");}
+        if (rands.size() != proc->parameters.size()) {
+            // 参数仍然需要求值（可能有副作用或错误）
+            for (Callable *r : rands) r->run(env);
+            throw RuntimeError("Wrong number of arguments");
+        }
+        param_env = proc->env;
+        if (!rands.empty()) {
+            param_env = extend(rands.size(), proc->env);
+            Value *slots = param_env->slots();
+            for (size_t i = 0; i < rands.size(); i++) {
+                slots[i] = rands[i]->run(env);
+            }
+        }
+        return proc;
+    }
+
+    template <bool Tail>
+    static Value run(Callable *c, Assoc &env) {
+        ApplyNode *n = static_cast<ApplyNode*>(c);
+        // 过程调用是垃圾回收的安全点
+        gcSafepoint();
+        checkNativeStack();
+        Value f = n->rator->run(env);
+        GCRoot fun_root(f);
+        if (Primitive *prim = f.as<Primitive>()) {
+            return n->applyPrimitive(prim, env);
+        }
+        Assoc param_env(nullptr);
+        GCRoot env_root(param_env);
+        Procedure *proc = n->bind(f, param_env, env);
+
+        // 尾调用：交给外层调用的蹦床执行
+        if (Tail) {
+            pending_call.proc = f;
+            pending_call.env = param_env;
+            return TailCallV();
+        }
+        while (true) {
+            // 不是由本引擎创建的过程第一次被调用时才编译
+            if (proc->compiled == nullptr) {
+                proc->compiled = compileCallable(proc->e, true);
+            }
+            Value result = proc->compiled->run(param_env);
+            if (result != TailCallV()) {
+                return result;
+            }
+            f = pending_call.proc;
+            param_env = pending_call.env;
+            proc = static_cast<Procedure*>(f.get());
+        }
+    }
+};
+
+// ================================================================================
+//                                 PRIMITIVES
+// ================================================================================
+
+// 二元原语的快速路径：返回 false 时交给对应节点的 evalRator
+#define FIXNUM_OP(name, result) \
+    struct name { \
+        static bool apply(const Value &v1, const Value &v2, Value &r) { \
+            if (!(v1.bits & v2.bits & 1)) return false; \
+            r = (result); \
+            return true; \
+        } \
+    };
+FIXNUM_OP(AddOp, ExactIntegerV((long long)v1.fixnum() + v2.fixnum()))
+FIXNUM_OP(SubOp, ExactIntegerV((long long)v1.fixnum() - v2.fixnum()))
+FIXNUM_OP(MulOp, ExactIntegerV((long long)v1.fixnum() * v2.fixnum()))
+FIXNUM_OP(LtOp, BooleanV(v1.fixnum() < v2.fixnum()))
+FIXNUM_OP(LeOp, BooleanV(v1.fixnum() <= v2.fixnum()))
+FIXNUM_OP(NumEqOp, BooleanV(v1.fixnum() == v2.fixnum()))
+FIXNUM_OP(GeOp, BooleanV(v1.fixnum() >= v2.fixnum()))
+FIXNUM_OP(GtOp, BooleanV(v1.fixnum() > v2.fixnum()))
+#undef FIXNUM_OP
+
+struct EqqOp {
+    static bool apply(const Value &v1, const Value &v2, Value &r) {
+        if (v1 != v2) return false;
+        r = BooleanV(true);
+        return true;
+    }
+};
+
+struct ConsOp {
+    static bool apply(const Value &v1, const Value &v2, Value &r) {
+        r = PairV(v1, v2);
+        return true;
+    }
+};
+
+struct AnyBinary {
+    static bool apply(const Value &, const Value &, Value &) { return false; }
+};
+
+struct CarOp {
+    static bool apply(const Value &v, Value &r) {
+        Pair *pair = v.as<Pair>();
+        if (pair == nullptr) return false;
+        r = pair->car;
+        return true;
+    }
+};
+
+struct CdrOp {
+    static bool apply(const Value &v, Value &r) {
+        Pair *pair = v.as<Pair>();
+        if (pair == nullptr) return false;
+        r = pair->cdr;
+        return true;
+    }
+};
+
+struct NullqOp {
+    static bool apply(const Value &v, Value &r) {
+        r = BooleanV(v.bits == IMM_NULL);
+        return true;
+    }
+};
+
+struct PairqOp {
+    static bool apply(const Value &v, Value &r) {
+        r = BooleanV(v.as<Pair>() != nullptr);
+        return true;
+    }
+};
+
+struct NotOp {
+    static bool apply(const Value &v, Value &r) {
+        r = BooleanV(v.bits == IMM_FALSE);
+        return true;
+    }
+};
+
+struct AnyUnary {
+    static bool apply(const Value &, Value &) { return false; }
+};
+
+/**
+ * @brief Binary primitive, either a Binary node (right operand first) or a
+ * call to a global primitive (arguments from left to right)
+ */
+struct BinaryNode : Callable {
+    Expr node;              // Binary 节点，负责快速路径以外的情况
+    Callable *rand1;
+    Callable *rand2;
+    bool second_safe;       // 后求值的操作数不经过安全点，先得到的值无需登记为根
+    BinaryNode(Fn f, const Expr &node, Callable *r1, Callable *r2, bool safe)
+        : Callable(f), node(node), rand1(r1), rand2(r2), second_safe(safe) {}
+    virtual void trace() override {
+        gcMark(node);
+        gcMark(rand1);
+        gcMark(rand2);
+    }
+
+    template <class Op>
+    Value apply(const Value &v1, const Value &v2) {
+        Value r(nullptr);
+        if (Op::apply(v1, v2, r)) return r;
+        return static_cast<Binary*>(node.get())->evalRator(v1, v2);
+    }
+
+    template <class Op>
+    static Value run(Callable *c, Assoc &env) {
+        BinaryNode *n = static_cast<BinaryNode*>(c);
+        checkNativeStack();
+        Value v2 = n->rand2->run(env);
+        if (n->second_safe) return n->apply<Op>(n->rand1->run(env), v2);
+        GCRoot root(v2);
+        return n->apply<Op>(n->rand1->run(env), v2);
+    }
+
+    template <class Op>
+    static Value runCall(Callable *c, Assoc &env) {
+        BinaryNode *n = static_cast<BinaryNode*>(c);
+        checkNativeStack();
+        Value v1 = n->rand1->run(env);
+        if (n->second_safe) return n->apply<Op>(v1, n->rand2->run(env));
+        GCRoot root(v1);
+        return n->apply<Op>(v1, n->rand2->run(env));
+    }
+};
+
+struct UnaryNode : Callable {
+    Expr node;
+    Callable *rand;
+    UnaryNode(Fn f, const Expr &node, Callable *rand) : Callable(f), node(node), rand(rand) {}
+    virtual void trace() override {
+        gcMark(node);
+        gcMark(rand);
+    }
+
+    template <class Op>
+    static Value run(Callable *c, Assoc &env) {
+        UnaryNode *n = static_cast<UnaryNode*>(c);
+        checkNativeStack();
+        Value v = n->rand->run(env);
+        Value r(nullptr);
+        if (Op::apply(v, r)) return r;
+        return static_cast<Unary*>(n->node.get())->evalRator(v);
+    }
+};
+
+struct VariadicNode : Callable {
+    Expr node;
+    vector<Callable *> rands;
+    static Value run(Callable *c, Assoc &env) {
+        VariadicNode *n = static_cast<VariadicNode*>(c);
+        checkNativeStack();
+        vector<Value> args;
+        GCRoot root(args);
+        for (Callable *r : n->rands) {
+            args.push_back(r->run(env));
+        }
+        return static_cast<Variadic*>(n->node.get())->evalRator(args);
+    }
+    VariadicNode(const Expr &node, const vector<Callable *> &rands) : Callable(&run), node(node), rands(rands) {}
+    virtual void trace() override {
+        gcMark(node);
+        gcMarkAll(rands);
+    }
+};
+
+template <class Op>
+Callable::Fn binaryFn(bool call) {
+    return call ? &BinaryNode::runCall<Op> : &BinaryNode::run<Op>;
+}
+
+Callable::Fn binaryFn(ExprType type, bool call) {
+    switch (type) {
+        case E_PLUS: return binaryFn<AddOp>(call);
+        case E_MINUS: return binaryFn<SubOp>(call);
+        case E_MUL: return binaryFn<MulOp>(call);
+        case E_LT: return binaryFn<LtOp>(call);
+        case E_LE: return binaryFn<LeOp>(call);
+        case E_EQ: return binaryFn<NumEqOp>(call);
+        case E_GE: return binaryFn<GeOp>(call);
+        case E_GT: return binaryFn<GtOp>(call);
+        case E_EQQ: return binaryFn<EqqOp>(call);
+        case E_CONS: return binaryFn<ConsOp>(call);
+        default: return binaryFn<AnyBinary>(call);
+    }
+}
+
+Callable::Fn unaryFn(ExprType type) {
+    switch (type) {
+        case E_CAR: return &UnaryNode::run<CarOp>;
+        case E_CDR: return &UnaryNode::run<CdrOp>;
+        case E_NULLQ: return &UnaryNode::run<NullqOp>;
+        case E_PAIRQ: return &UnaryNode::run<PairqOp>;
+        case E_NOT: return &UnaryNode::run<NotOp>;
+        default: return &UnaryNode::run<AnyUnary>;
+    }
+}
+
+// ================================================================================
+//                                 COMPILATION
+// ================================================================================
+
+/**
+ * @brief Whether evaluating e can never reach a collection
+ *
+ * Only procedure calls are safepoints, so leaves are always safe.
+ */
+bool isSafe(const Expr &e) {
+    switch (e->e_type) {
+        case E_VAR:
+        case E_FIXNUM:
+        case E_STRING:
+        case E_CONST:
+        case E_TRUE:
+        case E_FALSE:
+        case E_QUOTE:
+        case E_VOID:
+        case E_EXIT:
+        case E_LAMBDA:
+            return true;
+        default:
+            return false;
+    }
+}
+
+Callable *compile(const Expr &e, bool tail);
+
+vector<Callable *> compileAll(const vector<Expr> &es, size_t from = 0) {
+    vector<Callable *> cs;
+    for (size_t i = from; i < es.size(); i++) {
+        cs.push_back(compile(es[i], false));
+    }
+    return cs;
+}
+
+/**
+ * @brief Compile es[from..] in order, keeping only the value of the last
+ */
+Callable *compileSequence(const vector<Expr> &es, size_t from, bool tail) {
+    if (from + 1 == es.size()) return compile(es.back(), tail);
+    vector<Callable *> cs = compileAll(es, from);
+    cs.back() = compile(es.back(), tail);
+    return new SeqNode(&SeqNode::runBegin, cs);
+}
+
+Callable *compileVar(const Expr &e) {
+    Var *var = static_cast<Var*>(e.get());
+    if (var->malformed) {
+        // 非法变量名总是报错
+        return new ExprNode(e);
+    }
+    if (var->depth < 0) return new VarNode(&VarNode::runGlobal, e);
+    if (var->depth == 0) return new VarNode(&VarNode::runLocal0, e);
+    if (var->depth == 1) return new VarNode(&VarNode::runLocal1, e);
+    return new VarNode(&VarNode::runLocal, e);
+}
+
+Callable *compileAndOr(const vector<Expr> &es, bool is_and, bool tail) {
+    if (es.empty()) return new ConstNode(BooleanV(is_and));
+    if (es.size() == 1) return compile(es[0], tail);
+    vector<Callable *> cs = compileAll(es);
+    cs.back() = compile(es.back(), tail);
+    return new SeqNode(is_and ? &SeqNode::runAnd : &SeqNode::runOr, cs);
+}
+
+/**
+ * @brief Compile the clauses into a chain of if/or nodes
+ *
+ * The else clause is recognized here once; the clauses after it are dropped.
+ * The chain is built from its end, so long conds do not recurse.
+ */
+Callable *compileCond(const vector<vector<Expr>> &clauses, bool tail) {
+    static Sym else_sym = intern("else");
+    size_t end = 0;
+    Callable *rest = nullptr;
+    for (; end < clauses.size(); end++) {
+        const vector<Expr> &clause = clauses[end];
+        if (!clause.empty() && clause[0]->e_type == E_VAR && static_cast<Var*>(clause[0].get())->x == else_sym) {
+            rest = clause.size() == 1 ? new ConstNode(VoidV()) : compileSequence(clause, 1, tail);
+            break;
+        }
+    }
+    // 没有分支匹配，结果为 void
+    if (rest == nullptr) rest = new ConstNode(VoidV());
+    for (size_t i = end; i-- > 0;) {
+        const vector<Expr> &clause = clauses[i];
+        if (clause.empty()) continue;
+        if (clause.size() == 1) {
+            // 只有谓词的分支以谓词的值作为结果，相当于 (or pred rest)
+            rest = new SeqNode(&SeqNode::runOr, {compile(clause[0], false), rest});
+        } else {
+            rest = new IfNode(compile(clause[0], false), compileSequence(clause, 1, tail), rest);
+        }
+    }
+    return rest;
+}
+
+Callable *compileLet(const vector<std::pair<Sym, Expr>> &bind, const Expr &body, bool rec, bool tail) {
+    // 没有绑定时不创建帧（与解析时的作用域保持一致）
+    if (bind.empty()) return compile(body, tail);
+    vector<Callable *> inits;
+    for (const auto &b : bind) {
+        inits.push_back(compile(b.second, false));
+    }
+    return new LetNode(rec ? &LetNode::runLetrec : &LetNode::runLet, inits, compile(body, tail));
+}
+
+/**
+ * @brief Compile a call to the primitive named by a global variable
+ *
+ * Such a variable can be neither defined nor assigned, so the call can go
+ * to the primitive directly. Returns nullptr when the arity does not match,
+ * leaving the error to the general call path.
+ */
+Callable *compilePrimitiveCall(Apply *node, bool tail) {
+    Var *var = static_cast<Var*>(node->rator.get());
+    Expr body = primitiveBody(var->x);
+    if (body.get() == nullptr) return nullptr;
+    size_t arity = body.as<Binary>() ? 2 : body.as<Unary>() ? 1 : 0;
+    if (node->rand.size() != arity) return nullptr;
+    if (arity == 0) return compile(body, tail);
+    if (arity == 1) return new UnaryNode(unaryFn(body->e_type), body, compile(node->rand[0], false));
+    return new BinaryNode(binaryFn(body->e_type, true), body,
+                          compile(node->rand[0], false), compile(node->rand[1], false),
+                          isSafe(node->rand[1]));
+}
+
+Callable *compileApply(Apply *node, bool tail) {
+    if (node->rator->e_type == E_VAR) {
+        Var *var = static_cast<Var*>(node->rator.get());
+        if (var->depth < 0 && !var->malformed && var->x->primitive >= 0) {
+            if (Callable *c = compilePrimitiveCall(node, tail)) return c;
+        }
+    }
+    return new ApplyNode(tail ? &ApplyNode::run<true> : &ApplyNode::run<false>,
+                         compile(node->rator, false), compileAll(node->rand));
+}
+
+Callable *compile(const Expr &e, bool tail) {
+    // 每层嵌套递归一次，过深的表达式报错而不是耗尽栈
+    checkNativeStack();
+    switch (e->e_type) {
+        case E_FIXNUM: return new ConstNode(IntegerV(static_cast<Fixnum*>(e.get())->n));
+        case E_STRING: return new ConstNode(static_cast<StringExpr*>(e.get())->v);
+        case E_CONST: return new ConstNode(static_cast<Constant*>(e.get())->v);
+        case E_TRUE: return new ConstNode(BooleanV(true));
+        case E_FALSE: return new ConstNode(BooleanV(false));
+        case E_VOID: return new ConstNode(VoidV());
+        case E_EXIT: return new ConstNode(TerminateV());
+        case E_QUOTE: return new ConstNode(static_cast<Quote*>(e.get())->v);
+        case E_VAR: return compileVar(e);
+        case E_LAMBDA: {
+            Lambda *node = static_cast<Lambda*>(e.get());
+            return new LambdaNode(e, compile(node->e, true));
+        }
+        case E_IF: {
+            If *node = static_cast<If*>(e.get());
+            return new IfNode(compile(node->cond, false), compile(node->conseq, tail),
+                              compile(node->alter, tail));
+        }
+        case E_BEGIN: {
+            Begin *node = static_cast<Begin*>(e.get());
+            if (node->es.empty()) return new ConstNode(VoidV());
+            if (node->locals.empty()) return compileSequence(node->es, 0, tail);
+            // 内部定义的槽位在进入 body 时一次性创建
+            vector<Callable *> cs = compileAll(node->es);
+            cs.back() = compile(node->es.back(), tail);
+            return new SeqNode(&SeqNode::runBody, cs, node->locals.size());
+        }
+        case E_LET: {
+            Let *node = static_cast<Let*>(e.get());
+            return compileLet(node->bind, node->body, false, tail);
+        }
+        case E_LETREC: {
+            Letrec *node = static_cast<Letrec*>(e.get());
+            return compileLet(node->bind, node->body, true, tail);
+        }
+        case E_DEFINE: {
+            Define *node = static_cast<Define*>(e.get());
+            if (node->depth < 0 && (node->var->primitive >= 0 || node->var->reserved >= 0)) {
+                // 重定义原语必定报错
+                return new ExprNode(e);
+            }
+            return new StoreNode(node->depth >= 0 ? &StoreNode::runLocal : &StoreNode::runGlobal, e,
+                                 node->depth, node->index, node->global, compile(node->e, false));
+        }
+        case E_SET: {
+            Set *node = static_cast<Set*>(e.get());
+            return new StoreNode(&StoreNode::runSet, e, node->depth, node->index, node->global,
+                                 compile(node->e, false));
+        }
+        case E_AND: return compileAndOr(static_cast<And*>(e.get())->es, true, tail);
+        case E_OR: return compileAndOr(static_cast<Or*>(e.get())->es, false, tail);
+        case E_COND: return compileCond(static_cast<Cond*>(e.get())->clauses, tail);
+        case E_APPLY: return compileApply(static_cast<Apply*>(e.get()), tail);
+        default: break;
+    }
+    // 其余节点都是原语调用，按参数个数区分
+    if (Binary *node = e.as<Binary>()) {
+        return new BinaryNode(binaryFn(e->e_type, false), e, compile(node->rand1, false),
+                              compile(node->rand2, false), isSafe(node->rand1));
+    }
+    if (Unary *node = e.as<Unary>()) {
+        return new UnaryNode(unaryFn(e->e_type), e, compile(node->rand, false));
+    }
+    if (Variadic *node = e.as<Variadic>()) {
+        return new VariadicNode(e, compileAll(node->rands));
+    }
+    throw RuntimeError("Cannot compile expression");
+}
+
+} // namespace
+
+Callable *compileCallable(const Expr &e, bool tail) {
+    return compile(e, tail);
+}
+
+Value closureEval(const Expr &e, Assoc &env) {
+    Callable *c = compileCallable(e, false);
+    GCRoot root(&markCallableRoot, &c);
+    return c->run(env);
+}
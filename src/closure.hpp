@@ -0,0 +1,47 @@
+#ifndef CLOSURE_HPP
+#define CLOSURE_HPP
+
+/**
+ * @file closure.hpp
+ * @brief Closure-compilation engine
+ *
+ * Each Expr is compiled once into a tree of Callables: a C++ function paired
+ * with everything the node needs already resolved, such as the compiled
+ * operands, the lexical address or global cell of a variable, which cond
+ * clause is the else clause, or the primitive a call goes to. Evaluating a
+ * node is then a single indirect call that never looks at the Expr again.
+ *
+ * Environments, closures and values are shared with the tree walker, and
+ * rare or error-reporting paths fall back to the original node.
+ *
+ * Like the tree walker, a node runs its operands and a call runs the body
+ * by calling into them on the native stack, so nesting and non-tail
+ * recursion are bounded by native_stack_limit instead of max_eval_depth.
+ */
+
+#include "Def.hpp"
+#include "gc.hpp"
+#include "value.hpp"
+#include "expr.hpp"
+
+/**
+ * @brief Compiled expression: a function bound to its resolved operands
+ */
+struct Callable : GCObject {
+    typedef Value (*Fn)(Callable *, Assoc &);
+    Fn fn;                  ///< Specialized evaluation function of this node
+    Callable(Fn f) : fn(f) {}
+    Value run(Assoc &env) { return fn(this, env); }
+};
+
+/**
+ * @brief Compile a procedure body (tail) or a top-level expression
+ */
+Callable *compileCallable(const Expr &, bool);
+
+/**
+ * @brief Evaluate a top-level expression with the closure-compilation engine
+ */
+Value closureEval(const Expr &, Assoc &);
+
+#endif // CLOSURE_HPP
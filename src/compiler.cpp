@@ -0,0 +1,721 @@
+/**
+ * @file compiler.cpp
+ * @brief Compilation of expression trees into bytecode
+ *
+ * Each node is compiled for a context: in tail position its value is
+ * returned from the current procedure (calls become OP_TAIL_CALL), otherwise
+ * it is left on the operand stack. The compiler tracks the operand stack
+ * depth so the VM can reserve the room a body needs once, on entry.
+ *
+ * A body without lambdas can never capture its frames, so it is compiled
+ * flat: the arguments and the slots of its let, letrec and internal
+ * definitions stay on the operand stack, addressed from the frame pointer,
+ * and only the variables of the closure environment go through Frames.
+ */
+
+#include "bytecode.hpp"
+#include "RE.hpp"
+#include <algorithm>
+
+using std::vector;
+
+Code::Code() : flat(false), max_stack(0) {}
+
+void Code::trace() {
+    for (const Value &v : consts) gcMark(v);
+    for (const Expr &e : exprs) gcMark(e);
+    for (Code *c : codes) gcMark(c);
+}
+
+namespace {
+
+/**
+ * @brief Whether e creates a closure somewhere, which could capture frames
+ *
+ * The tree is walked with an explicit work list, so arbitrarily deep
+ * expressions do not use up the native stack here.
+ */
+bool hasLambda(const Expr &root) {
+    vector<Expr> work(1, root);
+    auto pushAll = [&work](const vector<Expr> &es) {
+        work.insert(work.end(), es.begin(), es.end());
+    };
+    while (!work.empty()) {
+        Expr e = work.back();
+        work.pop_back();
+        switch (e->e_type) {
+            case E_LAMBDA: return true;
+            case E_LET:
+            case E_LETREC: {
+                const auto &bind = e->e_type == E_LET ? static_cast<Let*>(e.get())->bind
+                                                      : static_cast<Letrec*>(e.get())->bind;
+                for (const auto &b : bind) work.push_back(b.second);
+                work.push_back(e->e_type == E_LET ? static_cast<Let*>(e.get())->body
+                                                  : static_cast<Letrec*>(e.get())->body);
+                continue;
+            }
+            case E_APPLY: {
+                Apply *node = static_cast<Apply*>(e.get());
+                work.push_back(node->rator);
+                pushAll(node->rand);
+                continue;
+            }
+            case E_IF: {
+                If *node = static_cast<If*>(e.get());
+                work.push_back(node->cond);
+                work.push_back(node->conseq);
+                work.push_back(node->alter);
+                continue;
+            }
+            case E_BEGIN: pushAll(static_cast<Begin*>(e.get())->es); continue;
+            case E_AND: pushAll(static_cast<And*>(e.get())->es); continue;
+            case E_OR: pushAll(static_cast<Or*>(e.get())->es); continue;
+            case E_COND:
+                for (const auto &clause : static_cast<Cond*>(e.get())->clauses) pushAll(clause);
+                continue;
+            case E_DEFINE: work.push_back(static_cast<Define*>(e.get())->e); continue;
+            case E_SET: work.push_back(static_cast<Set*>(e.get())->e); continue;
+            default: break;
+        }
+        if (Binary *node = e.as<Binary>()) {
+            work.push_back(node->rand1);
+            work.push_back(node->rand2);
+        } else if (Unary *node = e.as<Unary>()) {
+            work.push_back(node->rand);
+        } else if (Variadic *node = e.as<Variadic>()) {
+            pushAll(node->rands);
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief A node or sequence whose code is partly emitted
+ *
+ * Nodes are compiled on an explicit stack, like List::parse builds them,
+ * so deep expressions do not use up the native stack. Each step of an
+ * entry emits the code up to its next subexpression and hands that one
+ * out; the last step emits the code after the final subexpression.
+ */
+struct Pending {
+    Expr e;                     // 节点，为空时表示序列 (*seq)[from..]
+    const vector<Expr> *seq;
+    size_t from;
+    bool tail;
+    size_t step;                // 已交出的子表达式个数（cond 中为分支内的阶段）
+    size_t clause;              // cond 正在编译的分支
+    int base;                   // 栈上帧的起点
+    int jump;                   // 待回填的跳转
+    vector<int> to_end;         // 跳到末尾的跳转，节点结束时回填
+    Expr op;                    // 原地应用的原语，为空时是一般的过程调用
+
+    Pending(const Expr &e, bool tail)
+        : e(e), seq(nullptr), from(0), tail(tail), step(0), clause(0), base(0), jump(0), op(nullptr) {}
+    Pending(const vector<Expr> &es, size_t from, bool tail)
+        : e(nullptr), seq(&es), from(from), tail(tail), step(0), clause(0), base(0), jump(0), op(nullptr) {}
+};
+
+class Compiler {
+    Code *code;
+    int depth;              // operand stack depth at the current instruction
+    vector<int> frames;     // stack offsets of the flat frames, innermost last
+
+public:
+    // 扁平的过程体中，实参就是最外层的栈上帧
+    Compiler(Code *c, int nparams) : code(c), depth(0) {
+        if (code->flat && nparams > 0) {
+            frames.push_back(0);
+            adjust(nparams);
+        }
+    }
+
+    void compile(const Expr &e, bool tail);
+
+private:
+    void emit(int32_t word) { code->ops.push_back(word); }
+
+    // 记录一条指令对操作数栈的影响
+    void adjust(int delta) {
+        depth += delta;
+        code->max_stack = std::max(code->max_stack, depth);
+    }
+
+    int exprIndex(const Expr &e) {
+        code->exprs.push_back(e);
+        return code->exprs.size() - 1;
+    }
+
+    int constIndex(const Value &v) {
+        code->consts.push_back(v);
+        return code->consts.size() - 1;
+    }
+
+    int cellIndex(GlobalCell *cell) {
+        for (size_t i = 0; i < code->cells.size(); i++) {
+            if (code->cells[i] == cell) return i;
+        }
+        code->cells.push_back(cell);
+        return code->cells.size() - 1;
+    }
+
+    // 跳转指令：返回偏移量所在位置，稍后由 patch 填写
+    int emitJump(Opcode op) {
+        emit(op);
+        emit(0);
+        return code->ops.size() - 1;
+    }
+
+    void patch(int at) {
+        code->ops[at] = code->ops.size() - (at + 1);
+    }
+
+    void emitConst(const Value &v, bool tail) {
+        emit(OP_CONST);
+        emit(constIndex(v));
+        adjust(1);
+        ret(tail);
+    }
+
+    // 尾位置的值直接返回给调用者
+    void ret(bool tail) {
+        if (tail) emit(OP_RETURN);
+    }
+
+    // 局部变量位于栈上的帧时给出其相对帧指针的偏移
+    bool stackSlot(int var_depth, int index, int &offset) const {
+        if (var_depth >= int(frames.size())) return false;
+        offset = frames[frames.size() - 1 - var_depth] + index;
+        return true;
+    }
+
+    // 闭包环境中的帧深度（跳过栈上的帧）
+    int heapDepth(int var_depth) const {
+        return var_depth - frames.size();
+    }
+
+    // 交出下一个要编译的子表达式
+    static bool give(Pending &next, const Expr &e, bool tail) {
+        next = Pending(e, tail);
+        return true;
+    }
+
+    void emitStore(int var_depth, int index, GlobalCell *global);
+    void enterStackFrame(int base) { frames.push_back(base); }
+    void leaveStackFrame(int size, bool tail);
+
+    bool step(Pending &n, Pending &next);
+    bool stepSequence(Pending &n, Pending &next);
+    void compileVar(const Expr &e, bool tail);
+    void compileLambda(const Expr &e, bool tail);
+    bool stepIf(If *node, Pending &n, Pending &next);
+    bool stepBegin(Begin *node, Pending &n, Pending &next);
+    bool stepLet(Let *node, Pending &n, Pending &next);
+    bool stepLetrec(Letrec *node, Pending &n, Pending &next);
+    bool stepDefine(Pending &n, Pending &next);
+    bool stepSet(Pending &n, Pending &next);
+    bool stepAndOr(const vector<Expr> &es, bool is_and, Pending &n, Pending &next);
+    bool stepCond(Cond *node, Pending &n, Pending &next);
+    bool stepApply(Apply *node, Pending &n, Pending &next);
+    bool stepBinary(Pending &n, Pending &next);
+    void compileBinaryOp(const Expr &e, bool tail);
+    bool stepUnary(Pending &n, Pending &next);
+    void compileUnaryOp(const Expr &e, bool tail);
+    bool stepVariadic(Pending &n, Pending &next);
+};
+
+/**
+ * @brief Compile es[from..] in order, keeping only the value of the last
+ */
+bool Compiler::stepSequence(Pending &n, Pending &next) {
+    const vector<Expr> &es = *n.seq;
+    size_t i = n.from + n.step++;
+    if (i == es.size()) return false;
+    if (i > n.from) {
+        emit(OP_POP);
+        adjust(-1);
+    }
+    return give(next, es[i], n.tail && i + 1 == es.size());
+}
+
+/**
+ * @brief Store the top value into a variable and replace it by void
+ */
+void Compiler::emitStore(int var_depth, int index, GlobalCell *global) {
+    int offset;
+    if (var_depth < 0) {
+        emit(OP_STORE_GLOBAL);
+        emit(cellIndex(global));
+    } else if (stackSlot(var_depth, index, offset)) {
+        emit(OP_STORE_STACK);
+        emit(offset);
+    } else {
+        emit(OP_STORE_LOCAL);
+        emit(heapDepth(var_depth));
+        emit(index);
+    }
+}
+
+/**
+ * @brief Leave the innermost stack frame, dropping its slots from under the result
+ */
+void Compiler::leaveStackFrame(int size, bool tail) {
+    frames.pop_back();
+    // 尾位置已经返回，栈由 OP_RETURN 整体回收
+    if (!tail) {
+        emit(OP_SLIDE);
+        emit(size);
+    }
+    adjust(-size);
+}
+
+void Compiler::compileVar(const Expr &e, bool tail) {
+    Var *var = static_cast<Var*>(e.get());
+    int offset;
+    if (var->malformed) {
+        // 非法变量名总是报错，交给树遍历求值器处理
+        emit(OP_EVAL);
+        emit(exprIndex(e));
+    } else if (var->depth < 0) {
+        emit(OP_GLOBAL);
+        emit(cellIndex(var->global));
+        emit(exprIndex(e));
+    } else if (stackSlot(var->depth, var->index, offset)) {
+        emit(OP_STACK);
+        emit(offset);
+        emit(exprIndex(e));
+    } else if (heapDepth(var->depth) <= 1) {
+        emit(heapDepth(var->depth) == 0 ? OP_LOCAL0 : OP_LOCAL1);
+        emit(var->index);
+        emit(exprIndex(e));
+    } else {
+        emit(OP_LOCAL);
+        emit(heapDepth(var->depth));
+        emit(var->index);
+        emit(exprIndex(e));
+    }
+    adjust(1);
+    ret(tail);
+}
+
+void Compiler::compileLambda(const Expr &e, bool tail) {
+    Lambda *lambda = static_cast<Lambda*>(e.get());
+    // 过程体由新的 Compiler 编译，每层嵌套的 lambda 递归一次
+    checkNativeStack();
+    code->codes.push_back(compileCode(lambda->e, lambda->x.size()));
+    emit(OP_CLOSURE);
+    emit(exprIndex(e));
+    emit(code->codes.size() - 1);
+    adjust(1);
+    ret(tail);
+}
+
+bool Compiler::stepIf(If *node, Pending &n, Pending &next) {
+    switch (n.step++) {
+        case 0: return give(next, node->cond, false);
+        case 1:
+            n.jump = emitJump(OP_JFALSE);
+            adjust(-1);
+            return give(next, node->conseq, n.tail);
+        case 2:
+            adjust(-1);
+            if (!n.tail) n.to_end.push_back(emitJump(OP_JUMP));
+            patch(n.jump);
+            return give(next, node->alter, n.tail);
+        default:
+            for (int at : n.to_end) patch(at);
+            return false;
+    }
+}
+
+bool Compiler::stepBegin(Begin *node, Pending &n, Pending &next) {
+    int size = node->locals.size();
+    if (n.step++ == 0) {
+        if (node->es.empty()) {
+            emitConst(VoidV(), n.tail);
+            return false;
+        }
+        // 内部定义的槽位在进入 body 时一次性创建
+        if (size > 0 && code->flat) {
+            n.base = depth;
+            emit(OP_PUSH_UNBOUND);
+            emit(size);
+            adjust(size);
+            enterStackFrame(n.base);
+        } else if (size > 0) {
+            emit(OP_PUSH_FRAME);
+            emit(size);
+        }
+        next = Pending(node->es, 0, n.tail);
+        return true;
+    }
+    if (size > 0 && code->flat) {
+        leaveStackFrame(size, n.tail);
+    } else if (size > 0 && !n.tail) {
+        emit(OP_POP_FRAME);
+    }
+    return false;
+}
+
+bool Compiler::stepLet(Let *node, Pending &n, Pending &next) {
+    size_t size = node->bind.size();
+    size_t k = n.step++;
+    if (size == 0) {
+        return k == 0 && give(next, node->body, n.tail);
+    }
+    // 初值在外层环境中求值，随后整体移入新帧（扁平时留在栈上原地成为槽位）
+    if (k == 0) n.base = depth;
+    if (k < size) return give(next, node->bind[k].second, false);
+    if (k == size) {
+        if (code->flat) {
+            enterStackFrame(n.base);
+        } else {
+            emit(OP_BIND_FRAME);
+            emit(size);
+            adjust(-int(size));
+        }
+        return give(next, node->body, n.tail);
+    }
+    if (code->flat) {
+        leaveStackFrame(size, n.tail);
+    } else if (!n.tail) {
+        emit(OP_POP_FRAME);
+    }
+    return false;
+}
+
+bool Compiler::stepLetrec(Letrec *node, Pending &n, Pending &next) {
+    size_t size = node->bind.size();
+    size_t k = n.step++;
+    if (size == 0) {
+        return k == 0 && give(next, node->body, n.tail);
+    }
+    // 初值在新帧中求值，全部求值完毕后才写入槽位
+    if (k == 0 && code->flat) {
+        n.base = depth;
+        emit(OP_PUSH_UNBOUND);
+        emit(size);
+        adjust(size);
+        enterStackFrame(n.base);
+    } else if (k == 0) {
+        emit(OP_PUSH_FRAME);
+        emit(size);
+    }
+    if (k < size) return give(next, node->bind[k].second, false);
+    if (k == size) {
+        if (code->flat) {
+            emit(OP_FILL_STACK);
+            emit(n.base);
+            emit(size);
+        } else {
+            emit(OP_FILL_FRAME);
+            emit(size);
+        }
+        adjust(-int(size));
+        return give(next, node->body, n.tail);
+    }
+    if (code->flat) {
+        leaveStackFrame(size, n.tail);
+    } else if (!n.tail) {
+        emit(OP_POP_FRAME);
+    }
+    return false;
+}
+
+bool Compiler::stepDefine(Pending &n, Pending &next) {
+    Define *node = static_cast<Define*>(n.e.get());
+    if (n.step++ == 0) {
+        if (node->depth < 0 && (node->var->primitive >= 0 || node->var->reserved >= 0)) {
+            // 重定义原语必定报错，交给树遍历求值器处理
+            emit(OP_EVAL);
+            emit(exprIndex(n.e));
+            adjust(1);
+            ret(n.tail);
+            return false;
+        }
+        return give(next, node->e, false);
+    }
+    emitStore(node->depth, node->index, node->global);
+    ret(n.tail);
+    return false;
+}
+
+bool Compiler::stepSet(Pending &n, Pending &next) {
+    Set *node = static_cast<Set*>(n.e.get());
+    if (n.step++ == 0) {
+        int offset;
+        if (node->depth >= 0 && stackSlot(node->depth, node->index, offset)) {
+            emit(OP_SET_CHECK_STACK);
+            emit(exprIndex(n.e));
+            emit(offset);
+        } else {
+            emit(OP_SET_CHECK);
+            emit(exprIndex(n.e));
+            emit(node->depth < 0 ? -1 : heapDepth(node->depth));
+            emit(node->index);
+        }
+        return give(next, node->e, false);
+    }
+    emitStore(node->depth, node->index, node->global);
+    ret(n.tail);
+    return false;
+}
+
+bool Compiler::stepAndOr(const vector<Expr> &es, bool is_and, Pending &n, Pending &next) {
+    if (es.empty()) {
+        emitConst(BooleanV(is_and), n.tail);
+        return false;
+    }
+    // 短路：决定结果的值留在栈上直接跳到末尾
+    size_t k = n.step++;
+    if (k > 0 && k < es.size()) {
+        n.to_end.push_back(emitJump(is_and ? OP_JFALSE_KEEP : OP_JTRUE_KEEP));
+        adjust(-1);
+    }
+    if (k < es.size()) return give(next, es[k], n.tail && k + 1 == es.size());
+    for (int at : n.to_end) patch(at);
+    if (!n.to_end.empty()) ret(n.tail);
+    return false;
+}
+
+/**
+ * @brief Step through the clauses of a cond
+ *
+ * n.clause is the clause being compiled and n.step how far it got:
+ * 0 at its start, 1 after the test, 2 after the body, 3 after an else body.
+ */
+bool Compiler::stepCond(Cond *node, Pending &n, Pending &next) {
+    static Sym else_sym = intern("else");
+    const auto &clauses = node->clauses;
+    while (n.step != 3) {
+        if (n.step == 1) {
+            if (clauses[n.clause].size() == 1) {
+                // 只有谓词的分支以谓词的值作为结果
+                n.to_end.push_back(emitJump(OP_JTRUE_KEEP));
+                adjust(-1);
+                n.clause++;
+                n.step = 0;
+                continue;
+            }
+            n.jump = emitJump(OP_JFALSE);
+            adjust(-1);
+            n.step = 2;
+            next = Pending(clauses[n.clause], 1, n.tail);
+            return true;
+        }
+        if (n.step == 2) {
+            adjust(-1);
+            if (!n.tail) n.to_end.push_back(emitJump(OP_JUMP));
+            patch(n.jump);
+            n.clause++;
+            n.step = 0;
+            continue;
+        }
+
+        while (n.clause < clauses.size() && clauses[n.clause].empty()) n.clause++;
+        if (n.clause == clauses.size()) {
+            // 没有分支匹配，结果为 void
+            emitConst(VoidV(), n.tail);
+            break;
+        }
+        const auto &clause = clauses[n.clause];
+        // else 分支在编译时识别，之后的分支不会被执行
+        if (clause[0]->e_type == E_VAR && static_cast<Var*>(clause[0].get())->x == else_sym) {
+            if (clause.size() == 1) {
+                emitConst(VoidV(), n.tail);
+                break;
+            }
+            n.step = 3;
+            next = Pending(clause, 1, n.tail);
+            return true;
+        }
+        n.step = 1;
+        return give(next, clause[0], false);
+    }
+    for (int at : n.to_end) patch(at);
+    if (n.tail && !n.to_end.empty()) emit(OP_RETURN);
+    return false;
+}
+
+/**
+ * @brief The primitive a call can apply in place, or nullptr
+ *
+ * A global variable naming a primitive can be neither defined nor
+ * assigned, so the call can apply the primitive in place instead of
+ * building a procedure for it. Calls with the wrong arity get nullptr,
+ * leaving the error to the general call path.
+ */
+Expr primitiveCall(Apply *node) {
+    if (node->rator->e_type != E_VAR) return Expr(nullptr);
+    Var *var = static_cast<Var*>(node->rator.get());
+    if (var->depth >= 0 || var->malformed || var->x->primitive < 0) return Expr(nullptr);
+    Expr body = primitiveBody(var->x);
+    if (body.get() == nullptr) return body;
+    size_t arity = body.as<Binary>() ? 2 : body.as<Unary>() ? 1 : 0;
+    return node->rand.size() == arity ? body : Expr(nullptr);
+}
+
+bool Compiler::stepApply(Apply *node, Pending &n, Pending &next) {
+    size_t size = node->rand.size();
+    size_t k = n.step++;
+    if (k == 0) n.op = primitiveCall(node);
+    if (n.op.get() != nullptr) {
+        if (size == 0) return k == 0 && give(next, n.op, n.tail);
+        // 实参按调用的顺序从左到右求值，再交换成原语期望的顺序
+        if (k < size) return give(next, node->rand[k], false);
+        if (size == 2) {
+            emit(OP_SWAP);
+            compileBinaryOp(n.op, n.tail);
+        } else {
+            compileUnaryOp(n.op, n.tail);
+        }
+        return false;
+    }
+    if (k == 0) return give(next, node->rator, false);
+    if (k == 1) emit(OP_CHECK_PROC);
+    if (k <= size) return give(next, node->rand[k - 1], false);
+    emit(n.tail ? OP_TAIL_CALL : OP_CALL);
+    emit(size);
+    adjust(-int(size));
+    return false;
+}
+
+bool Compiler::stepBinary(Pending &n, Pending &next) {
+    Binary *node = static_cast<Binary*>(n.e.get());
+    // 与树遍历求值器一致：先求值右操作数
+    switch (n.step++) {
+        case 0: return give(next, node->rand2, false);
+        case 1: return give(next, node->rand1, false);
+        default:
+            compileBinaryOp(n.e, n.tail);
+            return false;
+    }
+}
+
+/**
+ * @brief Apply Binary e to the top value (rand1) and the one below (rand2)
+ */
+void Compiler::compileBinaryOp(const Expr &e, bool tail) {
+    Opcode op;
+    switch (e->e_type) {
+        case E_PLUS: op = OP_ADD; break;
+        case E_MINUS: op = OP_SUB; break;
+        case E_MUL: op = OP_MUL; break;
+        case E_LT: op = OP_LT; break;
+        case E_LE: op = OP_LE; break;
+        case E_EQ: op = OP_NUM_EQ; break;
+        case E_GE: op = OP_GE; break;
+        case E_GT: op = OP_GT; break;
+        case E_EQQ: op = OP_EQQ; break;
+        case E_CONS: op = OP_CONS; break;
+        default: op = OP_BINARY; break;
+    }
+    emit(op);
+    emit(exprIndex(e));
+    adjust(-1);
+    ret(tail);
+}
+
+bool Compiler::stepUnary(Pending &n, Pending &next) {
+    if (n.step++ == 0) return give(next, static_cast<Unary*>(n.e.get())->rand, false);
+    compileUnaryOp(n.e, n.tail);
+    return false;
+}
+
+/**
+ * @brief Apply Unary e to the top value
+ */
+void Compiler::compileUnaryOp(const Expr &e, bool tail) {
+    Opcode op;
+    switch (e->e_type) {
+        case E_CAR: op = OP_CAR; break;
+        case E_CDR: op = OP_CDR; break;
+        case E_NULLQ: op = OP_NULLQ; break;
+        case E_PAIRQ: op = OP_PAIRQ; break;
+        case E_NOT: op = OP_NOT; break;
+        default: op = OP_UNARY; break;
+    }
+    emit(op);
+    emit(exprIndex(e));
+    ret(tail);
+}
+
+bool Compiler::stepVariadic(Pending &n, Pending &next) {
+    Variadic *node = static_cast<Variadic*>(n.e.get());
+    size_t k = n.step++;
+    if (k < node->rands.size()) return give(next, node->rands[k], false);
+    emit(OP_VARIADIC);
+    emit(exprIndex(n.e));
+    emit(node->rands.size());
+    adjust(1 - int(node->rands.size()));
+    ret(n.tail);
+    return false;
+}
+
+/**
+ * @brief Advance n by one step
+ *
+ * Returns true with the next subexpression to compile in next, or false
+ * once all of n has been emitted.
+ */
+bool Compiler::step(Pending &n, Pending &next) {
+    if (n.e.get() == nullptr) return stepSequence(n, next);
+    const Expr &e = n.e;
+    bool tail = n.tail;
+    switch (e->e_type) {
+        case E_FIXNUM:
+            emit(OP_FIXNUM);
+            emit(static_cast<Fixnum*>(e.get())->n);
+            adjust(1);
+            ret(tail);
+            return false;
+        case E_STRING: emitConst(static_cast<StringExpr*>(e.get())->v, tail); return false;
+        case E_CONST: emitConst(static_cast<Constant*>(e.get())->v, tail); return false;
+        case E_TRUE: emitConst(BooleanV(true), tail); return false;
+        case E_FALSE: emitConst(BooleanV(false), tail); return false;
+        case E_VOID: emitConst(VoidV(), tail); return false;
+        case E_EXIT: emitConst(TerminateV(), tail); return false;
+        case E_QUOTE: emitConst(static_cast<Quote*>(e.get())->v, tail); return false;
+        case E_VAR: compileVar(e, tail); return false;
+        case E_LAMBDA: compileLambda(e, tail); return false;
+        case E_IF: return stepIf(static_cast<If*>(e.get()), n, next);
+        case E_BEGIN: return stepBegin(static_cast<Begin*>(e.get()), n, next);
+        case E_LET: return stepLet(static_cast<Let*>(e.get()), n, next);
+        case E_LETREC: return stepLetrec(static_cast<Letrec*>(e.get()), n, next);
+        case E_DEFINE: return stepDefine(n, next);
+        case E_SET: return stepSet(n, next);
+        case E_AND: return stepAndOr(static_cast<And*>(e.get())->es, true, n, next);
+        case E_OR: return stepAndOr(static_cast<Or*>(e.get())->es, false, n, next);
+        case E_COND: return stepCond(static_cast<Cond*>(e.get()), n, next);
+        case E_APPLY: return stepApply(static_cast<Apply*>(e.get()), n, next);
+        default: break;
+    }
+    // 其余节点都是原语调用，按参数个数区分
+    if (e.as<Binary>()) return stepBinary(n, next);
+    if (e.as<Unary>()) return stepUnary(n, next);
+    if (e.as<Variadic>()) return stepVariadic(n, next);
+    throw RuntimeError("Cannot compile expression");
+}
+
+void Compiler::compile(const Expr &root, bool tail) {
+    // 未完成的节点，最内层在末尾
+    vector<Pending> pending;
+    pending.push_back(Pending(root, tail));
+    Pending next(Expr(nullptr), false);
+    while (!pending.empty()) {
+        if (step(pending.back(), next)) {
+            pending.push_back(std::move(next));
+        } else {
+            pending.pop_back();
+        }
+    }
+}
+
+
+} // namespace
+
+Code *compileCode(const Expr &e, int nparams) {
+    Code *code = new Code();
+    code->flat = !hasLambda(e);
+    Compiler(code, nparams).compile(e, true);
+    return code;
+}
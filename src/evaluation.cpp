@@ -10,64 +10,38 @@
 
 #include "value.hpp"
 #include "expr.hpp" 
+#include "gc.hpp"
 #include "RE.hpp"
 #include "syntax.hpp"
+#include "bytecode.hpp"
+#include "closure.hpp"
+#include "numeric.hpp"
 #include <cstring>
 #include <vector>
 #include <map>
 #include <climits>
+#include <cmath>
+#include <algorithm>
+#include <sys/resource.h>
 
-extern std::map<std::string, ExprType> primitives;
-extern std::map<std::string, ExprType> reserved_words;
 
 // ================================================================================
 //                             CONTROL STRUCTURES
 // ================================================================================
 
-// Helper function to compare two numeric values
-// Returns: -1 if v1 < v2, 0 if v1 == v2, 1 if v1 > v2
-int compareNumericValues(const Value &v1, const Value &v2) {
-    if (v1->v_type == V_INT && v2->v_type == V_INT) {
-        int n1 = dynamic_cast<Integer*>(v1.get())->n;
-        int n2 = dynamic_cast<Integer*>(v2.get())->n;
-        return (n1 < n2) ? -1 : (n1 > n2) ? 1 : 0;
-    }
-    else if (v1->v_type == V_RATIONAL && v2->v_type == V_INT) {
-        Rational* r1 = dynamic_cast<Rational*>(v1.get());
-        int n2 = dynamic_cast<Integer*>(v2.get())->n;
-        int left = r1->numerator;
-        int right = n2 * r1->denominator;
-        return (left < right) ? -1 : (left > right) ? 1 : 0;
-    }
-    else if (v1->v_type == V_INT && v2->v_type == V_RATIONAL) {
-        int n1 = dynamic_cast<Integer*>(v1.get())->n;
-        Rational* r2 = dynamic_cast<Rational*>(v2.get());
-        int left = n1 * r2->denominator;
-        int right = r2->numerator;
-        return (left < right) ? -1 : (left > right) ? 1 : 0;
-    }
-    else if (v1->v_type == V_RATIONAL && v2->v_type == V_RATIONAL) {
-        Rational* r1 = dynamic_cast<Rational*>(v1.get());
-        Rational* r2 = dynamic_cast<Rational*>(v2.get());
-        int left = r1->numerator * r2->denominator;
-        int right = r2->numerator * r1->denominator;
-        return (left < right) ? -1 : (left > right) ? 1 : 0;
-    }
-    throw RuntimeError("Wrong typename in numeric comparison");
-}
-
 /**
  * @brief Evaluate Let expression
  * Creates new environment bindings and evaluates body in that context
  */
 Value Let::eval(Assoc &env) {
-    Assoc cur_env = env;
-    std::vector<std::pair<std::string, Value>> tobind;
-    for (auto binded_pair : bind) {
-        tobind.push_back({binded_pair.first, binded_pair.second->eval(env)});
-    }
-    for (auto binded_pair : tobind) {
-        cur_env = extend(binded_pair.first, binded_pair.second, cur_env);
+    checkNativeStack();
+    // 没有绑定时不创建帧（与解析时的作用域保持一致）
+    if (bind.empty()) return body->eval(env);
+    Assoc cur_env = extend(bind.size(), env);
+    GCRoot root(cur_env);
+    Value *slots = cur_env->slots();
+    for (size_t i = 0; i < bind.size(); i++) {
+        slots[i] = bind[i].second->eval(env);
     }
     return body->eval(cur_env);
 }
@@ -91,30 +65,74 @@ Value Lambda::eval(Assoc &env) { // lambda expression
  * Evaluates function and arguments, then executes function body in extended environment
  */
 
+/**
+ * @brief Call prepared by a tail-position Apply for the enclosing trampoline
+ *
+ * Only valid between a tail Apply returning TailCallV() and the trampoline
+ * picking it up; nothing can allocate in between.
+ */
+static struct {
+    Value proc = Value(nullptr);
+    Assoc env = Assoc(nullptr);
+} pending_call;
+
 Value Apply::eval(Assoc &e) {
-    Value mid_fun = rator->eval(e);
-    if (mid_fun->v_type != V_PROC) {throw RuntimeError("Attempt to apply a non-procedure");}
+    // 过程调用是垃圾回收的安全点：此时所有存活的临时值都已登记为根
+    gcSafepoint();
+    checkNativeStack();
 
-    Procedure* clos_ptr = dynamic_cast<Procedure*>(mid_fun.get());
-    
-    // 直接使用闭包的环境，然后为参数添加绑定
-    // 关键修改：确保我们修改的是真正的闭包环境
-    std::vector<Value> args;
+    Value mid_fun = rator->eval(e);
+    GCRoot fun_root(mid_fun);  // 函数体执行期间闭包（及其代码）必须存活
 
-    for (int i = 0; i < rand.size(); i++) {
-        args.push_back(rand[i]->eval(e));
+    // 原语过程：实参求值后直接调用，不需要帧
+    if (Primitive *prim = mid_fun.as<Primitive>()) {
+        std::vector<Value> args;
+        GCRoot args_root(args);
+        for (const auto &r : rand) {
+            args.push_back(r->eval(e));
+        }
+        return prim->apply(args.data(), args.size());
     }
 
-    if (args.size() != clos_ptr->parameters.size()) {throw RuntimeError("Wrong number of arguments");}
+    Procedure* clos_ptr = mid_fun.as<Procedure>();
+    if (clos_ptr == nullptr) {throw RuntimeError("Attempt to apply a non-procedure");}
+
+    if (rand.size() != clos_ptr->parameters.size()) {
+        // 参数仍然需要求值（可能有副作用或错误）
+        for (int i = 0; i < rand.size(); i++) {
+            rand[i]->eval(e);
+        }
+        throw RuntimeError("Wrong number of arguments");
+    }
 
-    // 在闭包环境基础上添加参数绑定
+    // 在闭包环境基础上创建参数帧，实参直接求值到槽位中；无参过程直接在闭包环境中执行
     Assoc param_env = clos_ptr->env;
-    for (int i = 0; i < clos_ptr->parameters.size(); i++) {
-        param_env = extend(clos_ptr->parameters[i], args[i], param_env);
+    GCRoot env_root(param_env);
+    if (!rand.empty()) {
+        param_env = extend(rand.size(), clos_ptr->env);
+        Value *slots = param_env->slots();
+        for (int i = 0; i < rand.size(); i++) {
+            slots[i] = rand[i]->eval(e);
+        }
     }
 
-    // 执行函数体
-    return clos_ptr->e->eval(param_env);
+    // 尾调用：交给外层调用的蹦床执行，不增加 C++ 栈深度
+    if (tail) {
+        pending_call.proc = mid_fun;
+        pending_call.env = param_env;
+        return TailCallV();
+    }
+
+    // 蹦床：执行函数体，函数体以尾调用结束时在本层继续执行被调用者
+    while (true) {
+        Value result = clos_ptr->e->eval(param_env);
+        if (result != TailCallV()) {
+            return result;
+        }
+        mid_fun = pending_call.proc;
+        param_env = pending_call.env;
+        clos_ptr = static_cast<Procedure*>(mid_fun.get());
+    }
 }
 
 // ================================================================================
@@ -125,41 +143,73 @@ Value Apply::eval(Assoc &e) {
  * @brief Evaluate Define expression - Delayed evaluation version supporting mutual recursion
  */
 Value Define::eval(Assoc &env) {
+    checkNativeStack();
+    if (depth >= 0) {
+        // 内部定义：槽位已由所在的 body 预留
+        Value val = e->eval(env);
+        bindingAt(depth, index, env) = val;
+        return VoidV();
+    }
+
     // 检查是否试图重新定义primitive函数
-    if (primitives.count(var) || reserved_words.count(var)) {
-        throw RuntimeError("Cannot redefine primitive: " + var);
+    if (var->primitive >= 0 || var->reserved >= 0) {
+        throw RuntimeError("Cannot redefine primitive: " + var->name);
     }
     
-    // 为了支持递归函数，先在环境中创建一个占位符绑定
-    env = extend(var, Value(nullptr), env);
-    
-    // 计算表达式的值（现在环境中已经有了该变量的绑定）
-    Value val = e->eval(env);
-    
-    // 更新绑定为实际值
-    modify(var, val, env);
+    // 全局变量的 cell 在解析时已经创建，递归函数可以直接引用它
+    global->v = e->eval(env);
     
     // define 返回 void
     return VoidV();
 }
 
+Engine engine = ENGINE_VM;
+size_t max_eval_depth = 4000000;
+uintptr_t native_stack_limit = 0;
+
+void initNativeStack() {
+    char here;
+    size_t size = 8 << 20;
+    struct rlimit limit;
+    if (getrlimit(RLIMIT_STACK, &limit) == 0) {
+        size = limit.rlim_cur == RLIM_INFINITY ? size_t(1) << 30 : limit.rlim_cur;
+    }
+    // 留出余量给原语、输出和异常展开，它们在两次检查之间也要用栈
+    size_t reserve = std::min(size / 2, size_t(1) << 20);
+    native_stack_limit = reinterpret_cast<uintptr_t>(&here) - (size - reserve);
+}
+
+void nativeStackExhausted() {
+    throw RuntimeError("Recursion too deep");
+}
+
+/**
+ * @brief Evaluate a top-level expression with the selected engine
+ */
+Value evaluate(const Expr &e, Assoc &env) {
+    switch (engine) {
+        case ENGINE_TREE: return e->eval(env);
+        case ENGINE_CLOSURE: return closureEval(e, env);
+        default: return vmEval(e, env);
+    }
+}
+
 /**
  * @brief Evaluate Letrec expression - Batch processing of multiple define statements supporting mutual recursion
  */
-Value evaluateDefineGroup(const std::vector<std::pair<std::string, Expr>>& defines, Assoc &env) {
-    // 第一阶段：为所有变量创建占位符绑定
+Value evaluateDefineGroup(const std::vector<std::pair<Sym, Expr>>& defines, Assoc &env) {
+    // 第一阶段：检查所有变量名（全局 cell 在解析时已经创建）
     for (const auto& def : defines) {
-        if (primitives.count(def.first) || reserved_words.count(def.first)) {
-            throw RuntimeError("Cannot redefine primitive: " + def.first);
+        if (def.first->primitive >= 0 || def.first->reserved >= 0) {
+            throw RuntimeError("Cannot redefine primitive: " + def.first->name);
         }
-        env = extend(def.first, Value(nullptr), env);
     }
     
     // 第二阶段：求值所有表达式并更新绑定
     Value last_result = VoidV();
     for (const auto& def : defines) {
-        Value val = def.second->eval(env);
-        modify(def.first, val, env);
+        Value val = evaluate(def.second, env);
+        globalCell(def.first)->v = val;
         last_result = VoidV(); // define 总是返回 void
     }
     
@@ -167,45 +217,41 @@ Value evaluateDefineGroup(const std::vector<std::pair<std::string, Expr>>& defin
 }
 
 Value Letrec::eval(Assoc &env) {
-    // 1. 在当前作用域的基础上创建一个新作用域 env1
-    Assoc env1 = env;
+    checkNativeStack();
+    if (bind.empty()) return body->eval(env);
 
-    // 2. 将 var* 与 Value(nullptr) 绑定并引入 env1
-    for (const auto &binding : bind) {
-        env1 = extend(binding.first, Value(nullptr), env1);
-    }
+    // 1-2. 在当前作用域的基础上创建一个新帧 env1，var* 均未绑定 (Value(nullptr))
+    Assoc env1 = extend(bind.size(), env);
+    GCRoot env_root(env1);
 
-    std::vector<std::pair<std::string,Value>> bindings;
+    std::vector<Value> bindings;
+    GCRoot bindings_root(bindings);
 
     // 3. 在 env1 下对 expr* 求值
     for (const auto &binding : bind) {
-        bindings.push_back(std::make_pair(binding.first, binding.second->eval(env1)));
+        bindings.push_back(binding.second->eval(env1));
     }
 
-    // 4. 在 env1 的基础上创建一个新作用域 env2
-    Assoc env2 = env1;
-
-    // 5. 将 var* 与其对应的值绑定并引入 env2
-    for (const auto &binding: bindings) {
-        modify(binding.first, binding.second, env2);
+    // 4. 将 var* 与其对应的值绑定
+    Value *slots = env1->slots();
+    for (size_t i = 0; i < bindings.size(); i++) {
+        slots[i] = bindings[i];
     }
 
-    // 6. 最后在 env2 下对 body 求值
-    return body->eval(env2);
+    // 5. 最后在 env1 下对 body 求值
+    return body->eval(env1);
 }
 
 Value Set::eval(Assoc &env) {
+    checkNativeStack();
     // 检查变量是否存在
-    Value var_value = find(var, env);
-    if (var_value.get() == nullptr) {
-        throw RuntimeError("Undefined variable in set!: " + var);
+    Value &slot = depth >= 0 ? bindingAt(depth, index, env) : global->v;
+    if (slot.isUnbound()) {
+        throw RuntimeError("Undefined variable in set!: " + var->name);
     }
     
-    // 计算新值
-    Value new_val = e->eval(env);
-    
-    // 修改环境中的变量值
-    modify(var, new_val, env);
+    // 计算新值并修改环境中的变量值
+    slot = e->eval(env);
     
     // set! 返回 void
     return VoidV();
@@ -219,60 +265,114 @@ Value Set::eval(Assoc &env) {
  * 变量求值
  * 在环境中查找变量的值
  */
-Value Var::eval(Assoc &e) { // evaluation of variable
-    if ((x.empty()) || (std::isdigit(x[0]) || x[0] == '.' || x[0] == '@')) 
-        throw RuntimeError("Wrong variable name");
-    for (int i = 0; i < x.size(); i++) {
-        if (x[i] == '#') {
-            throw(RuntimeError("undefined variable"));
-        }
+/**
+ * @brief Body of the procedure a primitive evaluates to when used as a value
+ *
+ * Binary primitives take parm1 and parm2 and unary ones parm, both bound in
+ * the frame of the call.
+ */
+Expr primitiveBody(Sym x) {
+    static Sym parm = intern("parm"), parm1 = intern("parm1"), parm2 = intern("parm2");
+    Expr exp = nullptr;
+    switch (x->primitive) {
+        case E_MUL: { exp = (new Mult(new Var(parm1, 0, 0), new Var(parm2, 0, 1))); break; }
+        case E_MINUS: { exp = (new Minus(new Var(parm1, 0, 0), new Var(parm2, 0, 1))); break; }
+        case E_PLUS: { exp = (new Plus(new Var(parm1, 0, 0), new Var(parm2, 0, 1))); break; }
+        case E_DIV: { exp = (new Div(new Var(parm1, 0, 0), new Var(parm2, 0, 1))); break; }
+        case E_LT: { exp = (new Less(new Var(parm1, 0, 0), new Var(parm2, 0, 1))); break; }
+        case E_LE: { exp = (new LessEq(new Var(parm1, 0, 0), new Var(parm2, 0, 1))); break; }
+        case E_EQ: { exp = (new Equal(new Var(parm1, 0, 0), new Var(parm2, 0, 1))); break; }
+        case E_GE: { exp = (new GreaterEq(new Var(parm1, 0, 0), new Var(parm2, 0, 1))); break; }
+        case E_GT: { exp = (new Greater(new Var(parm1, 0, 0), new Var(parm2, 0, 1))); break; }
+        case E_VOID: { exp = (new MakeVoid()); break; }
+        case E_EQQ: { exp = (new IsEq(new Var(parm1, 0, 0), new Var(parm2, 0, 1))); break; }
+        case E_BOOLQ: { exp = (new IsBoolean(new Var(parm, 0, 0))); break; }
+        case E_INTQ: { exp = (new IsFixnum(new Var(parm, 0, 0))); break; }
+        case E_NULLQ: { exp = (new IsNull(new Var(parm, 0, 0))); break; }
+        case E_PAIRQ: { exp = (new IsPair(new Var(parm, 0, 0))); break; }
+        case E_PROCQ: { exp = (new IsProcedure(new Var(parm, 0, 0))); break; }
+        case E_LISTQ: { exp = (new IsList(new Var(parm, 0, 0))); break; }
+        case E_SYMBOLQ: { exp = (new IsSymbol(new Var(parm, 0, 0))); break; }
+        case E_STRINGQ: { exp = (new IsString(new Var(parm, 0, 0))); break; }
+        case E_CONS: { exp = (new Cons(new Var(parm1, 0, 0), new Var(parm2, 0, 1))); break; }
+        case E_QUOTIENT: { exp = (new Quotient(new Var(parm1, 0, 0), new Var(parm2, 0, 1))); break; }
+        case E_MODULO: { exp = (new Modulo(new Var(parm1, 0, 0), new Var(parm2, 0, 1))); break; }
+        case E_EXPT: { exp = (new Expt(new Var(parm1, 0, 0), new Var(parm2, 0, 1))); break; }
+        case E_EXACT_TO_INEXACT: { exp = (new ExactToInexact(new Var(parm, 0, 0))); break; }
+        case E_INEXACT_TO_EXACT: { exp = (new InexactToExact(new Var(parm, 0, 0))); break; }
+        case E_NOT: { exp = (new Not(new Var(parm, 0, 0))); break; }
+        case E_CAR: { exp = (new Car(new Var(parm, 0, 0))); break; }
+        case E_CDR: { exp = (new Cdr(new Var(parm, 0, 0))); break; }
+        case E_SETCAR: { exp = (new SetCar(new Var(parm1, 0, 0), new Var(parm2, 0, 1))); break; }
+        case E_SETCDR: { exp = (new SetCdr(new Var(parm1, 0, 0), new Var(parm2, 0, 1))); break; }
+        case E_DISPLAY: { exp = (new Display(new Var(parm, 0, 0))); break; }
+        case E_EXIT: { exp = (new Exit()); break; }
+        case E_LIST: { exp = (new ListFunc(std::vector<Expr>())); break; }
+    }
+    return exp;
+}
+
+// 原语过程的实现：把实参直接交给过程体节点的 evalRator
+static Value applyNullary(Primitive *p, Value *, int) {
+    Assoc none = empty();
+    return p->body->eval(none);
+}
+
+static Value applyUnary(Primitive *p, Value *args, int) {
+    return static_cast<Unary*>(p->body.get())->evalRator(args[0]);
+}
+
+static Value applyBinary(Primitive *p, Value *args, int) {
+    return static_cast<Binary*>(p->body.get())->evalRator(args[0], args[1]);
+}
+
+static Value applyVariadic(Primitive *p, Value *args, int argc) {
+    return static_cast<Variadic*>(p->body.get())->evalRator(std::vector<Value>(args, args + argc));
+}
+
+static void markPrimitives(void *p) {
+    for (const Value &v : *static_cast<std::vector<Value> *>(p)) {
+        gcMark(v);
     }
+}
 
-    Value matched_value = find(x, e);
-    if (matched_value.get() == nullptr) {
-        if (primitives.count(x)) {
-            Expr exp = nullptr;
-            int type_name = primitives[x];
-            switch (type_name) {
-                case E_MUL: { exp = (new Mult(new Var("parm1"), new Var("parm2"))); break; }
-                case E_MINUS: { exp = (new Minus(new Var("parm1"), new Var("parm2"))); break; }
-                case E_PLUS: { exp = (new Plus(new Var("parm1"), new Var("parm2"))); break; }
-                case E_DIV: { exp = (new Div(new Var("parm1"), new Var("parm2"))); break; }
-                case E_LT: { exp = (new Less(new Var("parm1"), new Var("parm2"))); break; }
-                case E_LE: { exp = (new LessEq(new Var("parm1"), new Var("parm2"))); break; }
-                case E_EQ: { exp = (new Equal(new Var("parm1"), new Var("parm2"))); break; }
-                case E_GE: { exp = (new GreaterEq(new Var("parm1"), new Var("parm2"))); break; }
-                case E_GT: { exp = (new Greater(new Var("parm1"), new Var("parm2"))); break; }
-                case E_VOID: { exp = (new MakeVoid()); break; }
-                case E_EQQ: { exp = (new IsEq(new Var("parm1"), new Var("parm2"))); break; }
-                case E_BOOLQ: { exp = (new IsBoolean(new Var("parm"))); break; }
-                case E_INTQ: { exp = (new IsFixnum(new Var("parm"))); break; }
-                case E_NULLQ: { exp = (new IsNull(new Var("parm"))); break; }
-                case E_PAIRQ: { exp = (new IsPair(new Var("parm"))); break; }
-                case E_PROCQ: { exp = (new IsProcedure(new Var("parm"))); break; }
-                case E_LISTQ: { exp = (new IsList(new Var("parm"))); break; }
-                case E_SYMBOLQ: { exp = (new IsSymbol(new Var("parm"))); break; }
-                case E_STRINGQ: { exp = (new IsString(new Var("parm"))); break; }
-                case E_CONS: { exp = (new Cons(new Var("parm1"), new Var("parm2"))); break; }
-                case E_QUOTIENT: { exp = (new Quotient(new Var("parm1"), new Var("parm2"))); break; }
-                case E_MODULO: { exp = (new Modulo(new Var("parm1"), new Var("parm2"))); break; }
-                case E_EXPT: { exp = (new Expt(new Var("parm1"), new Var("parm2"))); break; }
-                case E_NOT: { exp = (new Not(new Var("parm"))); break; }
-                case E_CAR: { exp = (new Car(new Var("parm"))); break; }
-                case E_CDR: { exp = (new Cdr(new Var("parm"))); break; }
-                case E_SETCAR: { exp = (new SetCar(new Var("parm1"), new Var("parm2"))); break; }
-                case E_SETCDR: { exp = (new SetCdr(new Var("parm1"), new Var("parm2"))); break; }
-                case E_DISPLAY: { exp = (new Display(new Var("parm"))); break; }
-                case E_EXIT: { exp = (new Exit()); break; }
-            }
-            std::vector<std::string> parameters_;
-            if (dynamic_cast<Binary*>(exp.get())) {
-                parameters_.push_back("parm1");
-                parameters_.push_back("parm2");
-            } else if (dynamic_cast<Unary*>(exp.get())) {
-                parameters_.push_back("parm");
+/**
+ * @brief Procedure the primitive x evaluates to when used as a value
+ *
+ * Every primitive is allocated once, on the first reference to any of them,
+ * and lives for the rest of the run.
+ */
+Value primitiveValue(Sym x) {
+    static std::vector<Value> table;
+    if (table.empty()) {
+        table.assign(E_EXIT + 1, Value(nullptr));
+        for (const auto &entry : primitives) {
+            Sym name = intern(entry.first);
+            Expr body = primitiveBody(name);
+            int arity;
+            Primitive::Fn fn;
+            switch (body->arity) {
+                case ARITY_UNARY: arity = 1; fn = &applyUnary; break;
+                case ARITY_BINARY: arity = 2; fn = &applyBinary; break;
+                case ARITY_VARIADIC: arity = -1; fn = &applyVariadic; break;
+                default: arity = 0; fn = &applyNullary; break;
             }
-            return ProcedureV(parameters_, exp, e);
+            table[entry.second] = Value(new Primitive(name, arity, body, fn));
+        }
+        gcAddPermanentRoot(&markPrimitives, &table);
+    }
+    return table[x->primitive];
+}
+
+Value Var::eval(Assoc &e) { // evaluation of variable
+    if (malformed)
+        throw RuntimeError("Wrong variable name");
+
+    // 地址在解析时已经确定，这里不再需要按名字查找
+    Value matched_value = depth >= 0 ? bindingAt(depth, index, e) : global->v;
+    if (matched_value.isUnbound()) {
+        if (x->primitive >= 0) {
+            return primitiveValue(x);
         } else {
             throw(RuntimeError("undefined variable"));
         }
@@ -285,16 +385,17 @@ Value Fixnum::eval(Assoc &e) { // evaluation of a fixnum
 }
 
 Value StringExpr::eval(Assoc &e) { // evaluation of a string
-    return StringV(s);
+    return v;
 }
 
 Value If::eval(Assoc &e) {
+    checkNativeStack();
     // if expression (Scheme: 只有 #f 为假，其余都为真)
     Value valueof_condition = cond->eval(e);
     // 只有当条件是 Boolean 类型且值为 false 时，才返回 alter 分支
     // 其他所有情况（包括 null、数字、符号等）都返回 conseq 分支
-    if (valueof_condition->v_type == V_BOOL && 
-        dynamic_cast<Boolean*>(valueof_condition.get())->b == false) {
+    if (valueof_condition.type() == V_BOOL && 
+        valueof_condition.boolean() == false) {
         return alter->eval(e);
     } else {
         return conseq->eval(e);
@@ -310,52 +411,20 @@ Value False::eval(Assoc &e) { // evaluation of #f
 }
 
 Value Begin::eval(Assoc &e) {
+    checkNativeStack();
     if (es.size() == 0) return VoidV();
     
-    // 查找连续的内部定义
-    std::vector<std::pair<std::string, Expr>> internal_defs;
-    int first_non_define = 0;
-    
-    for (int i = 0; i < es.size(); i++) {
-        if (es[i]->e_type == E_DEFINE) {
-            Define* def = dynamic_cast<Define*>(es[i].get());
-            if (def) {
-                internal_defs.push_back({def->var, def->e});
-                first_non_define = i + 1;
-            } else {
-                break; // 不是连续的定义了
-            }
-        } else {
-            break; // 不是连续的定义了
-        }
-    }
-    
-    // 如果有内部定义，使用类似 letrec 的语义
-    if (!internal_defs.empty()) {
-        // 创建新环境，先绑定所有变量为 nullptr
-        Assoc new_env = e;
-        for (const auto &def : internal_defs) {
-            new_env = extend(def.first, Value(nullptr), new_env);
-        }
-        
-        // 在新环境中求值所有定义的表达式
-        for (const auto &def : internal_defs) {
-            Value val = def.second->eval(new_env);
-            modify(def.first, val, new_env);
-        }
-        
-        // 在新环境中执行剩余的表达式
-        if (first_non_define >= es.size()) {
-            return VoidV(); // 只有定义，没有其他表达式
-        }
-        
-        for (int i = first_non_define; i < es.size() - 1; i++) {
+    // 如果有内部定义，先为它们创建新作用域（类似 letrec* 的语义）
+    // Define 子表达式在求值时直接写入对应的槽位
+    if (!locals.empty()) {
+        Assoc new_env = extend(locals.size(), e);
+        GCRoot root(new_env);
+        for (int i = 0; i < es.size() - 1; i++) {
             es[i]->eval(new_env);
         }
         return es[es.size() - 1]->eval(new_env);
     }
     
-    // 没有内部定义，使用原来的逻辑
     for (int i = 0; i < es.size() - 1; i++) {
         es[i]->eval(e);
     }
@@ -363,6 +432,7 @@ Value Begin::eval(Assoc &e) {
 }
 
 Value And::eval(Assoc &e) {
+    checkNativeStack();
     // (and) → #t
     if (es.size() == 0) return BooleanV(true);
     
@@ -370,11 +440,8 @@ Value And::eval(Assoc &e) {
     for (int i = 0; i < es.size(); i++) {
         Value val = es[i]->eval(e);
         // 在 Scheme 中，只有 #f 是假值，其他都是真值
-        if (val->v_type == V_BOOL) {
-            Boolean* b = dynamic_cast<Boolean*>(val.get());
-            if (!b->b) {  // 如果是 #f
-                return BooleanV(false);
-            }
+        if (val == BooleanV(false)) {  // 如果是 #f
+            return BooleanV(false);
         }
         // 如果是最后一个参数，返回它的值
         if (i == es.size() - 1) {
@@ -385,6 +452,7 @@ Value And::eval(Assoc &e) {
 }
 
 Value Or::eval(Assoc &e) {
+    checkNativeStack();
     // (or) → #f
     if (es.size() == 0) return BooleanV(false);
     
@@ -392,11 +460,7 @@ Value Or::eval(Assoc &e) {
     for (int i = 0; i < es.size(); i++) {
         Value val = es[i]->eval(e);
         // 检查是否为 #f
-        bool is_false = false;
-        if (val->v_type == V_BOOL) {
-            Boolean* b = dynamic_cast<Boolean*>(val.get());
-            is_false = !b->b;
-        }
+        bool is_false = (val == BooleanV(false));
         
         if (!is_false) {  // 如果不是 #f，返回这个值
             return val;
@@ -411,14 +475,16 @@ Value Or::eval(Assoc &e) {
 }
 
 Value Cond::eval(Assoc &env) {
+    checkNativeStack();
     // cond 表达式求值
     for (const auto &clause : clauses) {
         if (clause.empty()) continue;
         
         // 检查是否为 else 分支
-        if (clause[0]->e_type == E_VAR) {
-            Var* var_expr = dynamic_cast<Var*>(clause[0].get());
-            if (var_expr && var_expr->x == "else") {
+        Var* var_expr = clause[0].as<Var>();
+        if (var_expr != nullptr) {
+            static Sym else_sym = intern("else");
+            if (var_expr->x == else_sym) {
                 // else 分支：求值所有表达式，返回最后一个
                 if (clause.size() == 1) {
                     return VoidV();  // 如果 else 分支没有表达式，返回 void
@@ -435,11 +501,7 @@ Value Cond::eval(Assoc &env) {
         Value pred_value = clause[0]->eval(env);
         
         // 在 Scheme 中，只有 #f 是假值
-        bool is_true = true;
-        if (pred_value->v_type == V_BOOL) {
-            Boolean* b = dynamic_cast<Boolean*>(pred_value.get());
-            is_true = b->b;
-        }
+        bool is_true = (pred_value != BooleanV(false));
         
         if (is_true) {
             // 谓词为真，求值该分支的所有表达式，返回最后一个
@@ -459,42 +521,11 @@ Value Cond::eval(Assoc &env) {
 }
 
 Value Quote::eval(Assoc& e) {
-    if (dynamic_cast<TrueSyntax*>(s.get())) 
-        return BooleanV(true);
-    else if (dynamic_cast<FalseSyntax*>(s.get())) 
-        return BooleanV(false);
-    else if (dynamic_cast<Number*>(s.get()))  // 修正：使用Number而不是Integer
-        return IntegerV(dynamic_cast<Number*>(s.get())->n);
-    else if (dynamic_cast<SymbolSyntax*>(s.get())) 
-        return SymbolV(dynamic_cast<SymbolSyntax*>(s.get())->s);
-    else if (dynamic_cast<StringSyntax*>(s.get())) 
-        return StringV(dynamic_cast<StringSyntax*>(s.get())->s);
-    else if (dynamic_cast<List*>(s.get())) {
-        auto stxs_got = dynamic_cast<List*>(s.get())->stxs; 
-        List* temp = new List;
-        if (dynamic_cast<List*>(s.get())->stxs.empty()) {
-            return NullV();
-        } else if (stxs_got.size() == 1) {
-            return PairV(Value(Quote(stxs_got[0]).eval(e)), NullV());
-        } else {
-            int pos = -1, cnt = 0, len = stxs_got.size();
-            for (int i = 0; i < len; i++) {
-                pos = (((dynamic_cast<SymbolSyntax*>(stxs_got[i].get())) && (dynamic_cast<SymbolSyntax*>(stxs_got[i].get())->s == ".")) ? (i) : (pos));
-                cnt = (((dynamic_cast<SymbolSyntax*>(stxs_got[i].get())) && (dynamic_cast<SymbolSyntax*>(stxs_got[i].get())->s == ".")) ? (cnt + 1) : (cnt));
-            }
-            if ((cnt > 1 || ((pos != len - 2) && (cnt))) || (cnt == 1 && (len < 3))) {
-                throw RuntimeError("Parm isn't fit");
-            }
-            if (len == 3) {
-                if ((dynamic_cast<SymbolSyntax*>(stxs_got[1].get())) && (dynamic_cast<SymbolSyntax*>(stxs_got[1].get())->s == ".")) {
-                    return PairV(Quote(stxs_got[0]).eval(e), Quote(stxs_got[2]).eval(e));
-                }
-            }
-            (*temp).stxs = std::vector<Syntax>(stxs_got.begin() + 1, stxs_got.end());
-            return PairV(Value(Quote(stxs_got.front()).eval(e)), Value(Quote(Syntax(temp)).eval(e)));
-        }
-    } else 
-        throw(RuntimeError("Unknown quoted typename"));
+    return v;
+}
+
+Value Constant::eval(Assoc &e) { // constant known at parse time
+    return v;
 }
 
 Value MakeVoid::eval(Assoc &e) { // (void)
@@ -506,15 +537,23 @@ Value Exit::eval(Assoc &e) { // (exit)
 }
 
 Value Binary::eval(Assoc &e) { // evaluation of two-operators primitive
-    return evalRator(rand1->eval(e), rand2->eval(e));
+    checkNativeStack();
+    // 先求值右操作数（与原先的求值顺序一致），求值左操作数期间它需要作为根
+    Value v2 = rand2->eval(e);
+    GCRoot root(v2);
+    Value v1 = rand1->eval(e);
+    return evalRator(v1, v2);
 }
 
 Value Unary::eval(Assoc &e) { // evaluation of single-operator primitive
+    checkNativeStack();
     return evalRator(rand->eval(e));
 }
 
 Value Variadic::eval(Assoc &e) { // evaluation of multi-operator primitive
+    checkNativeStack();
     std::vector<Value> args;
+    GCRoot root(args);
     for (const auto& r : rands) {
         args.push_back(r->eval(e));
     }
@@ -522,342 +561,85 @@ Value Variadic::eval(Assoc &e) { // evaluation of multi-operator primitive
 }
 
 Value Mult::evalRator(const Value &rand1, const Value &rand2) { // *
-    // 整数 * 整数
-    if (rand1->v_type == V_INT && rand2->v_type == V_INT) {
-        return IntegerV((dynamic_cast<Integer*>(rand1.get())->n) * (dynamic_cast<Integer*>(rand2.get())->n));
-    }
-    // 有理数 * 整数
-    else if (rand1->v_type == V_RATIONAL && rand2->v_type == V_INT) {
-        Rational* r1 = dynamic_cast<Rational*>(rand1.get());
-        int n2 = dynamic_cast<Integer*>(rand2.get())->n;
-        return RationalV(r1->numerator * n2, r1->denominator);
-    }
-    // 整数 * 有理数
-    else if (rand1->v_type == V_INT && rand2->v_type == V_RATIONAL) {
-        int n1 = dynamic_cast<Integer*>(rand1.get())->n;
-        Rational* r2 = dynamic_cast<Rational*>(rand2.get());
-        return RationalV(n1 * r2->numerator, r2->denominator);
-    }
-    // 有理数 * 有理数
-    else if (rand1->v_type == V_RATIONAL && rand2->v_type == V_RATIONAL) {
-        Rational* r1 = dynamic_cast<Rational*>(rand1.get());
-        Rational* r2 = dynamic_cast<Rational*>(rand2.get());
-        return RationalV(r1->numerator * r2->numerator, r1->denominator * r2->denominator);
-    }
-    throw(RuntimeError("Wrong typename"));
+    return numericOp(NUM_MUL, rand1, rand2);
 }
 
 Value Plus::evalRator(const Value &rand1, const Value &rand2) { // +
-    // 整数 + 整数
-    if (rand1->v_type == V_INT && rand2->v_type == V_INT) {
-        return IntegerV((dynamic_cast<Integer*>(rand1.get())->n) + (dynamic_cast<Integer*>(rand2.get())->n));
-    }
-    // 有理数 + 整数
-    else if (rand1->v_type == V_RATIONAL && rand2->v_type == V_INT) {
-        Rational* r1 = dynamic_cast<Rational*>(rand1.get());
-        int n2 = dynamic_cast<Integer*>(rand2.get())->n;
-        return RationalV(r1->numerator + n2 * r1->denominator, r1->denominator);
-    }
-    // 整数 + 有理数
-    else if (rand1->v_type == V_INT && rand2->v_type == V_RATIONAL) {
-        int n1 = dynamic_cast<Integer*>(rand1.get())->n;
-        Rational* r2 = dynamic_cast<Rational*>(rand2.get());
-        return RationalV(n1 * r2->denominator + r2->numerator, r2->denominator);
-    }
-    // 有理数 + 有理数
-    else if (rand1->v_type == V_RATIONAL && rand2->v_type == V_RATIONAL) {
-        Rational* r1 = dynamic_cast<Rational*>(rand1.get());
-        Rational* r2 = dynamic_cast<Rational*>(rand2.get());
-        return RationalV(r1->numerator * r2->denominator + r2->numerator * r1->denominator,
-                        r1->denominator * r2->denominator);
-    }
-    throw(RuntimeError("Wrong typename"));
+    return numericOp(NUM_ADD, rand1, rand2);
 }
 
 Value Minus::evalRator(const Value &rand1, const Value &rand2) { // -
-    // 整数 - 整数
-    if (rand1->v_type == V_INT && rand2->v_type == V_INT) {
-        return IntegerV((dynamic_cast<Integer*>(rand1.get())->n) - (dynamic_cast<Integer*>(rand2.get())->n));
-    }
-    // 有理数 - 整数
-    else if (rand1->v_type == V_RATIONAL && rand2->v_type == V_INT) {
-        Rational* r1 = dynamic_cast<Rational*>(rand1.get());
-        int n2 = dynamic_cast<Integer*>(rand2.get())->n;
-        return RationalV(r1->numerator - n2 * r1->denominator, r1->denominator);
-    }
-    // 整数 - 有理数
-    else if (rand1->v_type == V_INT && rand2->v_type == V_RATIONAL) {
-        int n1 = dynamic_cast<Integer*>(rand1.get())->n;
-        Rational* r2 = dynamic_cast<Rational*>(rand2.get());
-        return RationalV(n1 * r2->denominator - r2->numerator, r2->denominator);
-    }
-    // 有理数 - 有理数
-    else if (rand1->v_type == V_RATIONAL && rand2->v_type == V_RATIONAL) {
-        Rational* r1 = dynamic_cast<Rational*>(rand1.get());
-        Rational* r2 = dynamic_cast<Rational*>(rand2.get());
-        return RationalV(r1->numerator * r2->denominator - r2->numerator * r1->denominator,
-                        r1->denominator * r2->denominator);
-    }
-    throw(RuntimeError("Wrong typename"));
+    return numericOp(NUM_SUB, rand1, rand2);
 }
 
 Value Div::evalRator(const Value &rand1, const Value &rand2) { // /
-    // 整数 / 整数
-    if (rand1->v_type == V_INT && rand2->v_type == V_INT) {
-        int dividend = dynamic_cast<Integer*>(rand1.get())->n;
-        int divisor = dynamic_cast<Integer*>(rand2.get())->n;
-        if (divisor == 0) {
-            throw(RuntimeError("Division by zero"));
-        }
-        return RationalV(dividend, divisor);
-    }
-    // 有理数 / 整数
-    else if (rand1->v_type == V_RATIONAL && rand2->v_type == V_INT) {
-        Rational* r1 = dynamic_cast<Rational*>(rand1.get());
-        int n2 = dynamic_cast<Integer*>(rand2.get())->n;
-        if (n2 == 0) {
-            throw(RuntimeError("Division by zero"));
-        }
-        return RationalV(r1->numerator, r1->denominator * n2);
-    }
-    // 整数 / 有理数
-    else if (rand1->v_type == V_INT && rand2->v_type == V_RATIONAL) {
-        int n1 = dynamic_cast<Integer*>(rand1.get())->n;
-        Rational* r2 = dynamic_cast<Rational*>(rand2.get());
-        if (r2->numerator == 0) {
-            throw(RuntimeError("Division by zero"));
-        }
-        return RationalV(n1 * r2->denominator, r2->numerator);
-    }
-    // 有理数 / 有理数
-    else if (rand1->v_type == V_RATIONAL && rand2->v_type == V_RATIONAL) {
-        Rational* r1 = dynamic_cast<Rational*>(rand1.get());
-        Rational* r2 = dynamic_cast<Rational*>(rand2.get());
-        if (r2->numerator == 0) {
-            throw(RuntimeError("Division by zero"));
-        }
-        return RationalV(r1->numerator * r2->denominator, r1->denominator * r2->numerator);
-    }
-    throw(RuntimeError("Wrong typename"));
+    return numericOp(NUM_DIV, rand1, rand2);
 }
 
 Value Less::evalRator(const Value &rand1, const Value &rand2) { // <
-    // 整数 < 整数
-    if (rand1->v_type == V_INT && rand2->v_type == V_INT) {
-        return BooleanV((dynamic_cast<Integer*>(rand1.get())->n) < (dynamic_cast<Integer*>(rand2.get())->n));
-    }
-    // 有理数 < 整数
-    else if (rand1->v_type == V_RATIONAL && rand2->v_type == V_INT) {
-        Rational* r1 = dynamic_cast<Rational*>(rand1.get());
-        int n2 = dynamic_cast<Integer*>(rand2.get())->n;
-        return BooleanV(r1->numerator < n2 * r1->denominator);
-    }
-    // 整数 < 有理数
-    else if (rand1->v_type == V_INT && rand2->v_type == V_RATIONAL) {
-        int n1 = dynamic_cast<Integer*>(rand1.get())->n;
-        Rational* r2 = dynamic_cast<Rational*>(rand2.get());
-        return BooleanV(n1 * r2->denominator < r2->numerator);
-    }
-    // 有理数 < 有理数
-    else if (rand1->v_type == V_RATIONAL && rand2->v_type == V_RATIONAL) {
-        Rational* r1 = dynamic_cast<Rational*>(rand1.get());
-        Rational* r2 = dynamic_cast<Rational*>(rand2.get());
-        return BooleanV(r1->numerator * r2->denominator < r2->numerator * r1->denominator);
-    }
-    throw(RuntimeError("Wrong typename"));
+    return BooleanV(numericCompare(rand1, rand2) & NUM_LT);
 }
 
 Value LessEq::evalRator(const Value &rand1, const Value &rand2) { // <=
-    if (rand1->v_type == V_INT and rand2->v_type == V_INT) {
-        return BooleanV((dynamic_cast<Integer*>(rand1.get())->n) <= (dynamic_cast<Integer*>(rand2.get())->n));
-    }
-    throw(RuntimeError("Wrong typename"));
+    return BooleanV(numericCompare(rand1, rand2) & (NUM_LT | NUM_EQ));
 }
 
 Value Equal::evalRator(const Value &rand1, const Value &rand2) { // =
-    // 整数 = 整数
-    if (rand1->v_type == V_INT && rand2->v_type == V_INT) {
-        return BooleanV((dynamic_cast<Integer*>(rand1.get())->n) == (dynamic_cast<Integer*>(rand2.get())->n));
-    }
-    // 有理数 = 整数
-    else if (rand1->v_type == V_RATIONAL && rand2->v_type == V_INT) {
-        Rational* r1 = dynamic_cast<Rational*>(rand1.get());
-        int n2 = dynamic_cast<Integer*>(rand2.get())->n;
-        return BooleanV(r1->numerator == n2 * r1->denominator);
-    }
-    // 整数 = 有理数
-    else if (rand1->v_type == V_INT && rand2->v_type == V_RATIONAL) {
-        int n1 = dynamic_cast<Integer*>(rand1.get())->n;
-        Rational* r2 = dynamic_cast<Rational*>(rand2.get());
-        return BooleanV(n1 * r2->denominator == r2->numerator);
-    }
-    // 有理数 = 有理数
-    else if (rand1->v_type == V_RATIONAL && rand2->v_type == V_RATIONAL) {
-        Rational* r1 = dynamic_cast<Rational*>(rand1.get());
-        Rational* r2 = dynamic_cast<Rational*>(rand2.get());
-        return BooleanV(r1->numerator * r2->denominator == r2->numerator * r1->denominator);
-    }
-    throw(RuntimeError("Wrong typename"));
+    return BooleanV(numericCompare(rand1, rand2) & NUM_EQ);
 }
 
 Value GreaterEq::evalRator(const Value &rand1, const Value &rand2) { // >=
-    // 整数 >= 整数
-    if (rand1->v_type == V_INT && rand2->v_type == V_INT) {
-        return BooleanV((dynamic_cast<Integer*>(rand1.get())->n) >= (dynamic_cast<Integer*>(rand2.get())->n));
-    }
-    // 有理数 >= 整数
-    else if (rand1->v_type == V_RATIONAL && rand2->v_type == V_INT) {
-        Rational* r1 = dynamic_cast<Rational*>(rand1.get());
-        int n2 = dynamic_cast<Integer*>(rand2.get())->n;
-        return BooleanV(r1->numerator >= n2 * r1->denominator);
-    }
-    // 整数 >= 有理数
-    else if (rand1->v_type == V_INT && rand2->v_type == V_RATIONAL) {
-        int n1 = dynamic_cast<Integer*>(rand1.get())->n;
-        Rational* r2 = dynamic_cast<Rational*>(rand2.get());
-        return BooleanV(n1 * r2->denominator >= r2->numerator);
-    }
-    // 有理数 >= 有理数
-    else if (rand1->v_type == V_RATIONAL && rand2->v_type == V_RATIONAL) {
-        Rational* r1 = dynamic_cast<Rational*>(rand1.get());
-        Rational* r2 = dynamic_cast<Rational*>(rand2.get());
-        return BooleanV(r1->numerator * r2->denominator >= r2->numerator * r1->denominator);
-    }
-    throw(RuntimeError("Wrong typename"));
+    return BooleanV(numericCompare(rand1, rand2) & (NUM_GT | NUM_EQ));
 }
 
 Value Greater::evalRator(const Value &rand1, const Value &rand2) { // >
-    // 整数 > 整数
-    if (rand1->v_type == V_INT && rand2->v_type == V_INT) {
-        return BooleanV((dynamic_cast<Integer*>(rand1.get())->n) > (dynamic_cast<Integer*>(rand2.get())->n));
-    }
-    // 有理数 > 整数
-    else if (rand1->v_type == V_RATIONAL && rand2->v_type == V_INT) {
-        Rational* r1 = dynamic_cast<Rational*>(rand1.get());
-        int n2 = dynamic_cast<Integer*>(rand2.get())->n;
-        return BooleanV(r1->numerator > n2 * r1->denominator);
-    }
-    // 整数 > 有理数
-    else if (rand1->v_type == V_INT && rand2->v_type == V_RATIONAL) {
-        int n1 = dynamic_cast<Integer*>(rand1.get())->n;
-        Rational* r2 = dynamic_cast<Rational*>(rand2.get());
-        return BooleanV(n1 * r2->denominator > r2->numerator);
-    }
-    // 有理数 > 有理数
-    else if (rand1->v_type == V_RATIONAL && rand2->v_type == V_RATIONAL) {
-        Rational* r1 = dynamic_cast<Rational*>(rand1.get());
-        Rational* r2 = dynamic_cast<Rational*>(rand2.get());
-        return BooleanV(r1->numerator * r2->denominator > r2->numerator * r1->denominator);
-    }
-    throw(RuntimeError("Wrong typename"));
+    return BooleanV(numericCompare(rand1, rand2) & NUM_GT);
 }
 
-Value LessVar::evalRator(const std::vector<Value> &args) { // < with multiple args
+// 链式比较：每对相邻参数的比较结果都在 accept 之中时为真
+static Value compareChain(const std::vector<Value> &args, int accept, const char *name) {
     if (args.size() < 2) {
-        throw(RuntimeError("< requires at least 2 arguments"));
+        throw(RuntimeError(std::string(name) + " requires at least 2 arguments"));
     }
-    
-    for (size_t i = 0; i < args.size() - 1; i++) {
-        if ((args[i]->v_type != V_INT && args[i]->v_type != V_RATIONAL) || 
-            (args[i+1]->v_type != V_INT && args[i+1]->v_type != V_RATIONAL)) {
-            throw(RuntimeError("Wrong typename"));
-        }
-        if (compareNumericValues(args[i], args[i+1]) >= 0) {
+    for (size_t i = 0; i + 1 < args.size(); i++) {
+        if (!(numericCompare(args[i], args[i + 1]) & accept)) {
             return BooleanV(false);
         }
     }
     return BooleanV(true);
 }
 
+Value LessVar::evalRator(const std::vector<Value> &args) { // < with multiple args
+    return compareChain(args, NUM_LT, "<");
+}
+
 Value LessEqVar::evalRator(const std::vector<Value> &args) { // <= with multiple args
-    if (args.size() < 2) {
-        throw(RuntimeError("<= requires at least 2 arguments"));
-    }
-    
-    for (size_t i = 0; i < args.size() - 1; i++) {
-        if (args[i]->v_type != V_INT || args[i+1]->v_type != V_INT) {
-            throw(RuntimeError("Wrong typename"));
-        }
-        int n1 = dynamic_cast<Integer*>(args[i].get())->n;
-        int n2 = dynamic_cast<Integer*>(args[i+1].get())->n;
-        if (!(n1 <= n2)) {
-            return BooleanV(false);
-        }
-    }
-    return BooleanV(true);
+    return compareChain(args, NUM_LT | NUM_EQ, "<=");
 }
 
 Value EqualVar::evalRator(const std::vector<Value> &args) { // = with multiple args
-    if (args.size() < 2) {
-        throw(RuntimeError("= requires at least 2 arguments"));
-    }
-    
-    for (size_t i = 0; i < args.size() - 1; i++) {
-        if ((args[i]->v_type != V_INT && args[i]->v_type != V_RATIONAL) || 
-            (args[i+1]->v_type != V_INT && args[i+1]->v_type != V_RATIONAL)) {
-            throw(RuntimeError("Wrong typename"));
-        }
-        if (compareNumericValues(args[i], args[i+1]) != 0) {
-            return BooleanV(false);
-        }
-    }
-    return BooleanV(true);
+    return compareChain(args, NUM_EQ, "=");
 }
 
 Value GreaterEqVar::evalRator(const std::vector<Value> &args) { // >= with multiple args
-    if (args.size() < 2) {
-        throw(RuntimeError(">= requires at least 2 arguments"));
-    }
-    
-    for (size_t i = 0; i < args.size() - 1; i++) {
-        if ((args[i]->v_type != V_INT && args[i]->v_type != V_RATIONAL) || 
-            (args[i+1]->v_type != V_INT && args[i+1]->v_type != V_RATIONAL)) {
-            throw(RuntimeError("Wrong typename"));
-        }
-        if (compareNumericValues(args[i], args[i+1]) < 0) {
-            return BooleanV(false);
-        }
-    }
-    return BooleanV(true);
+    return compareChain(args, NUM_GT | NUM_EQ, ">=");
 }
 
 Value GreaterVar::evalRator(const std::vector<Value> &args) { // > with multiple args
-    if (args.size() < 2) {
-        throw(RuntimeError("> requires at least 2 arguments"));
-    }
-    
-    for (size_t i = 0; i < args.size() - 1; i++) {
-        if ((args[i]->v_type != V_INT && args[i]->v_type != V_RATIONAL) || 
-            (args[i+1]->v_type != V_INT && args[i+1]->v_type != V_RATIONAL)) {
-            throw(RuntimeError("Wrong typename"));
-        }
-        if (compareNumericValues(args[i], args[i+1]) <= 0) {
-            return BooleanV(false);
-        }
-    }
-    return BooleanV(true);
+    return compareChain(args, NUM_GT, ">");
 }
 
 Value IsEq::evalRator(const Value &rand1, const Value &rand2) { // eq?
-    // 检查类型是否为 Integer
-    if (rand1->v_type == V_INT && rand2->v_type == V_INT) {
-        return BooleanV((dynamic_cast<Integer*>(rand1.get())->n) == (dynamic_cast<Integer*>(rand2.get())->n));
-    }
-    // 检查类型是否为 Boolean
-    else if (rand1->v_type == V_BOOL && rand2->v_type == V_BOOL) {
-        return BooleanV((dynamic_cast<Boolean*>(rand1.get())->b) == (dynamic_cast<Boolean*>(rand2.get())->b));
-    }
-    // 检查类型是否为 Symbol
-    else if (rand1->v_type == V_SYM && rand2->v_type == V_SYM) {
-        return BooleanV((dynamic_cast<Symbol*>(rand1.get())->s) == (dynamic_cast<Symbol*>(rand2.get())->s));
-    }
-    // 检查类型是否为 Null 或 Void
-    else if ((rand1->v_type == V_NULL && rand2->v_type == V_NULL) ||
-             (rand1->v_type == V_VOID && rand2->v_type == V_VOID)) {
+    // 整数、布尔值、null 和 void 都是立即数，相同的值编码也相同
+    if (rand1 == rand2) {
         return BooleanV(true);
-    } else {
-        return BooleanV(rand1.get() == rand2.get());
     }
+    // 检查类型是否为 Symbol（符号已驻留，比较指针即可）
+    Symbol *sym1 = rand1.as<Symbol>(), *sym2 = rand2.as<Symbol>();
+    if (sym1 != nullptr && sym2 != nullptr) {
+        return BooleanV(sym1->s == sym2->s);
+    }
+    return BooleanV(false);
 }
 
 Value Cons::evalRator(const Value &rand1, const Value &rand2) { // cons
@@ -865,113 +647,137 @@ Value Cons::evalRator(const Value &rand1, const Value &rand2) { // cons
 }
 
 Value Quotient::evalRator(const Value &rand1, const Value &rand2) { // quotient
-    if (rand1->v_type == V_INT and rand2->v_type == V_INT) {
-        int dividend = dynamic_cast<Integer*>(rand1.get())->n;
-        int divisor = dynamic_cast<Integer*>(rand2.get())->n;
-        if (divisor == 0) {
-            throw(RuntimeError("Division by zero"));
-        }
-        // 向零截断的除法（C++ 的默认行为）
-        return IntegerV(dividend / divisor);
-    }
-    throw(RuntimeError("Wrong typename"));
+    return numericOp(NUM_QUOTIENT, rand1, rand2);
 }
 
 Value Modulo::evalRator(const Value &rand1, const Value &rand2) { // modulo
-    if (rand1->v_type == V_INT and rand2->v_type == V_INT) {
-        int dividend = dynamic_cast<Integer*>(rand1.get())->n;
-        int divisor = dynamic_cast<Integer*>(rand2.get())->n;
-        if (divisor == 0) {
-            throw(RuntimeError("Division by zero"));
-        }
-        
-        int result = dividend % divisor;
-        // 确保结果与除数同号（除非结果为0）
-        if (result != 0 && ((result > 0) != (divisor > 0))) {
-            result += divisor;
-        }
-        return IntegerV(result);
-    }
-    throw(RuntimeError("Wrong typename"));
+    return numericOp(NUM_MODULO, rand1, rand2);
 }
 
 Value Expt::evalRator(const Value &rand1, const Value &rand2) { // expt
-    if (rand1->v_type == V_INT and rand2->v_type == V_INT) {
-        int base = dynamic_cast<Integer*>(rand1.get())->n;
-        int exponent = dynamic_cast<Integer*>(rand2.get())->n;
+    if ((rand1.type() == V_FLONUM || rand2.type() == V_FLONUM) && isNumber(rand1) && isNumber(rand2)) {
+        return FlonumV(std::pow(toDouble(rand1), toDouble(rand2)));
+    }
+    if (isExactInteger(rand1) and isExactInteger(rand2)) {
+        if (rand2.type() != V_INT) {
+            throw(RuntimeError("Exponent too large"));
+        }
+        int exponent = rand2.fixnum();
         
         // 处理特殊情况
         if (exponent < 0) {
             throw(RuntimeError("Negative exponent not supported for integers"));
         }
-        if (base == 0 && exponent == 0) {
+        if (rand1 == IntegerV(0) && exponent == 0) {
             throw(RuntimeError("0^0 is undefined"));
         }
         
-        // 计算 base^exponent
-        long long result = 1;
-        long long b = base;
+        // 快速幂：结果留在 fixnum 范围内时用机器整数，溢出后改用 BigInt
+        if (rand1.type() == V_INT) {
+            long long result = 1;
+            long long b = rand1.fixnum();
+            int exp = exponent;
+            bool overflow = false;
+            while (exp > 0) {
+                if (exp % 2 == 1) {
+                    result *= b;
+                    if (result > INT_MAX || result < INT_MIN) {
+                        overflow = true;
+                        break;
+                    }
+                }
+                exp /= 2;
+                if (exp > 0) {
+                    b *= b;
+                    if (b > INT_MAX || b < INT_MIN) {
+                        overflow = true;
+                        break;
+                    }
+                }
+            }
+            if (!overflow) {
+                return IntegerV((int)result);
+            }
+        }
+        BigInt result(1), b = toBigInt(rand1);
         int exp = exponent;
-        
-        // 使用快速幂算法
         while (exp > 0) {
             if (exp % 2 == 1) {
-                result *= b;
-                // 检查溢出
-                if (result > INT_MAX || result < INT_MIN) {
-                    throw(RuntimeError("Integer overflow in expt"));
-                }
-            }
-            b *= b;
-            if (b > INT_MAX || b < INT_MIN) {
-                if (exp > 1) {
-                    throw(RuntimeError("Integer overflow in expt"));
-                }
+                result = result * b;
             }
             exp /= 2;
+            if (exp > 0) {
+                b = b * b;
+            }
         }
-        
-        return IntegerV((int)result);
+        return ExactIntegerV(result);
     }
     throw(RuntimeError("Wrong typename"));
 }
 
 Value IsBoolean::evalRator(const Value &rand) { // boolean?
-    return BooleanV(rand->v_type == V_BOOL);
+    return BooleanV(rand.type() == V_BOOL);
 }
 
 Value IsFixnum::evalRator(const Value &rand) { // fixnum?
-    return BooleanV(rand->v_type == V_INT);
+    return BooleanV(isNumber(rand));
+}
+
+Value ExactToInexact::evalRator(const Value &rand) { // exact->inexact
+    if (rand.type() == V_FLONUM) {
+        return rand;
+    }
+    if (isExact(rand)) {
+        return FlonumV(toDouble(rand));
+    }
+    throw(RuntimeError("Wrong typename"));
+}
+
+Value InexactToExact::evalRator(const Value &rand) { // inexact->exact
+    if (isExact(rand)) {
+        return rand;
+    }
+    if (Flonum *f = rand.as<Flonum>()) {
+        if (!std::isfinite(f->d)) {
+            throw(RuntimeError("No exact representation"));
+        }
+        // 整数值的 double 不经过有理数内核
+        if (f->d >= INT_MIN && f->d <= INT_MAX && f->d == (int)f->d) {
+            return IntegerV((int)f->d);
+        }
+        return ExactRationalV(exactRatio(f->d));
+    }
+    throw(RuntimeError("Wrong typename"));
 }
 
 Value IsSymbol::evalRator(const Value &rand) { // symbol?
-    return BooleanV(rand->v_type == V_SYM);
+    return BooleanV(rand.type() == V_SYM);
 }
 
 Value IsString::evalRator(const Value &rand) { // string?
-    return BooleanV(rand->v_type == V_STRING);
+    return BooleanV(rand.type() == V_STRING);
 }
 
 Value IsNull::evalRator(const Value &rand) { // null?
-    return BooleanV(rand->v_type == V_NULL);
+    return BooleanV(rand.type() == V_NULL);
 }
 
 Value IsPair::evalRator(const Value &rand) { // pair?
-    return BooleanV(rand->v_type == V_PAIR);
+    return BooleanV(rand.type() == V_PAIR);
 }
 
 Value IsProcedure::evalRator(const Value &rand) { // procedure?
-    return BooleanV(rand->v_type == V_PROC);
+    return BooleanV(rand.type() == V_PROC || rand.type() == V_PRIMITIVE);
 }
 
 Value IsList::evalRator(const Value &rand) { // list?
     // 在 Scheme 中，list? 检查值是否为正常列表（包括空列表）
     // 正常列表是以 null 结尾的 pair 链，或者就是 null
-    if (rand->v_type == V_NULL) {
+    if (rand.type() == V_NULL) {
         return BooleanV(true); // 空列表是列表
     }
     
-    if (rand->v_type != V_PAIR) {
+    if (rand.type() != V_PAIR) {
         return BooleanV(false); // 不是 pair 就不是列表
     }
     
@@ -981,13 +787,13 @@ Value IsList::evalRator(const Value &rand) { // list?
     
     while (true) {
         // 快指针前进两步
-        if (fast->v_type != V_PAIR) break;
-        fast = dynamic_cast<Pair*>(fast.get())->cdr;
-        if (fast->v_type != V_PAIR) break;
-        fast = dynamic_cast<Pair*>(fast.get())->cdr;
+        if (fast.type() != V_PAIR) break;
+        fast = fast.as<Pair>()->cdr;
+        if (fast.type() != V_PAIR) break;
+        fast = fast.as<Pair>()->cdr;
         
         // 慢指针前进一步
-        slow = dynamic_cast<Pair*>(slow.get())->cdr;
+        slow = slow.as<Pair>()->cdr;
         
         // 检测环形
         if (slow.get() == fast.get()) {
@@ -996,109 +802,46 @@ Value IsList::evalRator(const Value &rand) { // list?
     }
     
     // 检查最后是否以 null 结尾
-    return BooleanV(fast->v_type == V_NULL);
+    return BooleanV(fast.type() == V_NULL);
 }
 
 Value Not::evalRator(const Value &rand) { // not
-    if (rand->v_type == V_BOOL and (dynamic_cast<Boolean*>(rand.get())->b == false))
+    if (rand.type() == V_BOOL and (rand.boolean() == false))
         return BooleanV(true);
     else
         return BooleanV(false);
 }
 
 Value Car::evalRator(const Value &rand) { // car
-    if (rand->v_type == V_PAIR)
-        return dynamic_cast<Pair*>(rand.get())->car;
+    if (Pair *pair_ptr = rand.as<Pair>())
+        return pair_ptr->car;
     else
         throw(RuntimeError("Wrong typename"));
 }
 
 Value Cdr::evalRator(const Value &rand) { // cdr
-    if (rand->v_type == V_PAIR)
-        return dynamic_cast<Pair*>(rand.get())->cdr;
+    if (Pair *pair_ptr = rand.as<Pair>())
+        return pair_ptr->cdr;
     else
         throw(RuntimeError("Wrong typename"));
 }
 
-// 多参数算术运算符实现
-Value MultVar::evalRator(const std::vector<Value> &args) { // * with multiple args
-    if (args.empty()) {
-        return IntegerV(1); // (* ) → 1 (multiplicative identity)
-    }
-    
-    // Check if any argument is rational
-    bool hasRational = false;
-    for (const auto& arg : args) {
-        if (arg->v_type == V_RATIONAL) {
-            hasRational = true;
-            break;
-        } else if (arg->v_type != V_INT) {
-            throw(RuntimeError("Wrong typename"));
-        }
-    }
-    
-    if (hasRational) {
-        // Result will be rational - use RationalV arithmetic
-        int numerator = 1, denominator = 1;
-        for (const auto& arg : args) {
-            if (arg->v_type == V_INT) {
-                numerator *= dynamic_cast<Integer*>(arg.get())->n;
-            } else if (arg->v_type == V_RATIONAL) {
-                Rational* r = dynamic_cast<Rational*>(arg.get());
-                numerator *= r->numerator;
-                denominator *= r->denominator;
-            }
-        }
-        return RationalV(numerator, denominator);
-    } else {
-        // All integers - use integer arithmetic
-        int result = 1;
-        for (const auto& arg : args) {
-            result *= dynamic_cast<Integer*>(arg.get())->n;
-        }
-        return IntegerV(result);
+// 多参数算术运算符实现：从左到右两两经过与二元运算相同的分派表
+static Value foldNumeric(NumOp op, Value acc, const std::vector<Value> &args, size_t from) {
+    for (size_t i = from; i < args.size(); i++) {
+        acc = numericOp(op, acc, args[i]);
     }
+    return acc;
+}
+
+Value MultVar::evalRator(const std::vector<Value> &args) { // * with multiple args
+    // (* ) → 1，从乘法单位元开始折叠，单个参数也经过类型检查
+    return foldNumeric(NUM_MUL, IntegerV(1), args, 0);
 }
 
 Value PlusVar::evalRator(const std::vector<Value> &args) { // + with multiple args
-    if (args.empty()) {
-        return IntegerV(0); // (+ ) → 0 (additive identity)
-    }
-    
-    // Check if any argument is rational
-    bool hasRational = false;
-    for (const auto& arg : args) {
-        if (arg->v_type == V_RATIONAL) {
-            hasRational = true;
-            break;
-        } else if (arg->v_type != V_INT) {
-            throw(RuntimeError("Wrong typename"));
-        }
-    }
-    
-    if (hasRational) {
-        // Result will be rational - start with 0/1
-        int numerator = 0, denominator = 1;
-        for (const auto& arg : args) {
-            if (arg->v_type == V_INT) {
-                int n = dynamic_cast<Integer*>(arg.get())->n;
-                numerator = numerator + n * denominator; // Add integer as n/1
-            } else if (arg->v_type == V_RATIONAL) {
-                Rational* r = dynamic_cast<Rational*>(arg.get());
-                // Add r->numerator/r->denominator to numerator/denominator
-                numerator = numerator * r->denominator + r->numerator * denominator;
-                denominator = denominator * r->denominator;
-            }
-        }
-        return RationalV(numerator, denominator);
-    } else {
-        // All integers - use integer arithmetic
-        int result = 0;
-        for (const auto& arg : args) {
-            result += dynamic_cast<Integer*>(arg.get())->n;
-        }
-        return IntegerV(result);
-    }
+    // (+ ) → 0
+    return foldNumeric(NUM_ADD, IntegerV(0), args, 0);
 }
 
 Value MinusVar::evalRator(const std::vector<Value> &args) { // - with multiple args
@@ -1106,88 +849,10 @@ Value MinusVar::evalRator(const std::vector<Value> &args) { // - with multiple a
         throw(RuntimeError("Wrong number of arguments for -"));
     }
     if (args.size() == 1) {
-        // (- x) → -x (negation)
-        if (args[0]->v_type == V_INT) {
-            return IntegerV(-(dynamic_cast<Integer*>(args[0].get())->n));
-        } else if (args[0]->v_type == V_RATIONAL) {
-            Rational* r = dynamic_cast<Rational*>(args[0].get());
-            return RationalV(-(r->numerator), r->denominator);
-        } else {
-            throw(RuntimeError("Wrong typename"));
-        }
-    }
-    
-    // Check if any argument is rational
-    bool hasRational = false;
-    for (const auto& arg : args) {
-        if (arg->v_type == V_RATIONAL) {
-            hasRational = true;
-            break;
-        } else if (arg->v_type != V_INT) {
-            throw(RuntimeError("Wrong typename"));
-        }
-    }
-    
-    if (hasRational) {
-        // Result will be rational
-        int numerator, denominator;
-        
-        // Initialize with first argument
-        if (args[0]->v_type == V_INT) {
-            numerator = dynamic_cast<Integer*>(args[0].get())->n;
-            denominator = 1;
-        } else {
-            Rational* r = dynamic_cast<Rational*>(args[0].get());
-            numerator = r->numerator;
-            denominator = r->denominator;
-        }
-        
-        // Subtract remaining arguments
-        for (size_t i = 1; i < args.size(); i++) {
-            if (args[i]->v_type == V_INT) {
-                int n = dynamic_cast<Integer*>(args[i].get())->n;
-                numerator = numerator - n * denominator;
-            } else if (args[i]->v_type == V_RATIONAL) {
-                Rational* r = dynamic_cast<Rational*>(args[i].get());
-                numerator = numerator * r->denominator - r->numerator * denominator;
-                denominator = denominator * r->denominator;
-            }
-        }
-        return RationalV(numerator, denominator);
-    } else {
-        // All integers - use integer arithmetic
-        int result = dynamic_cast<Integer*>(args[0].get())->n;
-        for (size_t i = 1; i < args.size(); i++) {
-            result -= dynamic_cast<Integer*>(args[i].get())->n;
-        }
-        return IntegerV(result);
+        // (- x) → -1 * x，保留浮点 0 的符号
+        return numericOp(NUM_MUL, IntegerV(-1), args[0]);
     }
-}
-
-// GCD 辅助函数（用于有理数化简）
-static int gcd_helper(int a, int b) {
-    if (a < 0) a = -a;
-    if (b < 0) b = -b;
-    while (b != 0) {
-        int temp = b;
-        b = a % b;
-        a = temp;
-    }
-    return a;
-}
-
-// 有理数乘法
-static Value multiply_rationals(int num1, int den1, int num2, int den2) {
-    int new_num = num1 * num2;
-    int new_den = den1 * den2;
-    int g = gcd_helper(new_num, new_den);
-    new_num /= g;
-    new_den /= g;
-    if (new_den < 0) {
-        new_num = -new_num;
-        new_den = -new_den;
-    }
-    return RationalV(new_num, new_den);
+    return foldNumeric(NUM_SUB, args[0], args, 1);
 }
 
 Value DivVar::evalRator(const std::vector<Value> &args) { // / with multiple args
@@ -1196,75 +861,35 @@ Value DivVar::evalRator(const std::vector<Value> &args) { // / with multiple arg
     }
     if (args.size() == 1) {
         // (/ x) → 1/x (reciprocal)
-        if (args[0]->v_type == V_INT) {
-            int n = dynamic_cast<Integer*>(args[0].get())->n;
-            if (n == 0) throw(RuntimeError("Division by zero"));
-            return RationalV(1, n);
-        } else if (args[0]->v_type == V_RATIONAL) {
-            auto rat = dynamic_cast<Rational*>(args[0].get());
-            if (rat->numerator == 0) throw(RuntimeError("Division by zero"));
-            return RationalV(rat->denominator, rat->numerator);
-        } else {
-            throw(RuntimeError("Wrong typename"));
-        }
+        return numericOp(NUM_DIV, IntegerV(1), args[0]);
     }
-    
     // (/ x y z ...) → x / y / z / ...
-    int num, den;
-    if (args[0]->v_type == V_INT) {
-        num = dynamic_cast<Integer*>(args[0].get())->n;
-        den = 1;
-    } else if (args[0]->v_type == V_RATIONAL) {
-        auto rat = dynamic_cast<Rational*>(args[0].get());
-        num = rat->numerator;
-        den = rat->denominator;
-    } else {
-        throw(RuntimeError("Wrong typename"));
-    }
-    
-    for (size_t i = 1; i < args.size(); i++) {
-        if (args[i]->v_type == V_INT) {
-            int divisor = dynamic_cast<Integer*>(args[i].get())->n;
-            if (divisor == 0) throw(RuntimeError("Division by zero"));
-            num *= 1;
-            den *= divisor;
-        } else if (args[i]->v_type == V_RATIONAL) {
-            auto rat = dynamic_cast<Rational*>(args[i].get());
-            if (rat->numerator == 0) throw(RuntimeError("Division by zero"));
-            num *= rat->denominator;
-            den *= rat->numerator;
-        } else {
-            throw(RuntimeError("Wrong typename"));
-        }
-    }
-    
-    int g = gcd_helper(num, den);
-    num /= g;
-    den /= g;
-    if (den < 0) {
-        num = -num;
-        den = -den;
-    }
-    return RationalV(num, den);
+    return foldNumeric(NUM_DIV, args[0], args, 1);
 }
 
 Value SetCar::evalRator(const Value &rand1, const Value &rand2) { // set-car!
-    if (rand1->v_type != V_PAIR) {
+    Pair* pair_ptr = rand1.as<Pair>();
+    if (pair_ptr == nullptr) {
         throw RuntimeError("set-car!: argument must be a pair");
     }
+    if (pair_ptr->immutable) {
+        throw RuntimeError("set-car!: cannot modify a constant");
+    }
     
-    Pair* pair_ptr = dynamic_cast<Pair*>(rand1.get());
     pair_ptr->car = rand2;
     
     return VoidV();
 }
 
 Value SetCdr::evalRator(const Value &rand1, const Value &rand2) { // set-cdr!
-    if (rand1->v_type != V_PAIR) {
+    Pair* pair_ptr = rand1.as<Pair>();
+    if (pair_ptr == nullptr) {
         throw RuntimeError("set-cdr!: argument must be a pair");
     }
+    if (pair_ptr->immutable) {
+        throw RuntimeError("set-cdr!: cannot modify a constant");
+    }
     
-    Pair* pair_ptr = dynamic_cast<Pair*>(rand1.get());
     pair_ptr->cdr = rand2;
     
     return VoidV();
@@ -1291,13 +916,12 @@ Value ListFunc::evalRator(const std::vector<Value> &args) { // list function
 
 Value Display::evalRator(const Value &rand) { // display function
     // display 输出值但不换行，字符串不显示引号
-    if (rand->v_type == V_STRING) {
+    if (String* str_ptr = rand.as<String>()) {
         // 对于字符串，输出内容但不包括引号
-        String* str_ptr = dynamic_cast<String*>(rand.get());
-        std::cout << str_ptr->s;
+        output << str_ptr->s;
     } else {
         // 对于其他类型，使用标准显示方法
-        rand->show(std::cout);
+        rand.show(output);
     }
     
     return VoidV();
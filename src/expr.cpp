@@ -1,59 +1,129 @@
 #include "Def.hpp"
 #include "expr.hpp"
+#include "value.hpp"
 #include <cstring>
+#include <cctype>
 #include <vector>
 using std::vector;
 using std::string;
 using std::pair;
 
-ExprBase::ExprBase(ExprType et) : e_type(et) {}
+ExprBase::ExprBase(ExprType et, ExprArity a) : e_type(et), arity(a) {}
 
 Expr::Expr(ExprBase * eb) : ptr(eb) {}
-ExprBase* Expr::operator->() const { return ptr.get(); }
+ExprBase* Expr::operator->() const { return ptr; }
 ExprBase& Expr::operator*() { return *ptr; }
-ExprBase* Expr::get() const { return ptr.get(); }
+ExprBase* Expr::get() const { return ptr; }
 
-Let::Let(const vector<pair<string, Expr>> &vec, const Expr &e) : ExprBase(E_LET), bind(vec), body(e) {}
+Let::Let(const vector<pair<Sym, Expr>> &vec, const Expr &e) : ExprBase(E_LET), bind(vec), body(e) {}
 
-Lambda::Lambda(const vector<string> &vec, const Expr &expr) : ExprBase(E_LAMBDA), x(vec), e(expr) {}
+void Let::trace() {
+    for (const auto &b : bind) gcMark(b.second);
+    gcMark(body);
+}
 
-Apply::Apply(const Expr &expr, const vector<Expr> &vec) : ExprBase(E_APPLY), rator(expr), rand(vec) {}
+Lambda::Lambda(const vector<Sym> &vec, const Expr &expr) : ExprBase(E_LAMBDA), x(vec), e(expr) {}
 
-Define::Define(const string &variable, const Expr &expr) : ExprBase(E_DEFINE), var(variable), e(expr) {}
+void Lambda::trace() { gcMark(e); }
 
-Letrec::Letrec(const vector<pair<string, Expr>> &vec, const Expr &expr) : ExprBase(E_LETREC), bind(vec), body(expr) {}
+Apply::Apply(const Expr &expr, const vector<Expr> &vec) : ExprBase(E_APPLY), rator(expr), rand(vec), tail(false) {}
 
-Var::Var(const string &s) : ExprBase(E_VAR), x(s) {}
+void Apply::trace() {
+    gcMark(rator);
+    for (const auto &r : rand) gcMark(r);
+}
+
+Define::Define(Sym variable, const Expr &expr, int d, int i) : ExprBase(E_DEFINE), var(variable), e(expr), depth(d), index(i),
+    global(d < 0 ? globalCell(variable) : nullptr) {}
+
+void Define::trace() { gcMark(e); }
+
+Letrec::Letrec(const vector<pair<Sym, Expr>> &vec, const Expr &expr) : ExprBase(E_LETREC), bind(vec), body(expr) {}
+
+void Letrec::trace() {
+    for (const auto &b : bind) gcMark(b.second);
+    gcMark(body);
+}
+
+Var::Var(Sym s, int d, int i) : ExprBase(E_VAR), x(s), depth(d), index(i), global(d < 0 ? globalCell(s) : nullptr) {
+    const string &name = s->name;
+    malformed = name.empty() || std::isdigit(name[0]) || name[0] == '.' || name[0] == '@' || name.find('#') != string::npos;
+}
 
 Fixnum::Fixnum(int x) : ExprBase(E_FIXNUM), n(x) {}
 
-StringExpr::StringExpr(const std::string &str) : ExprBase(E_STRING), s(str) {}
+StringExpr::StringExpr(const std::string &str) : ExprBase(E_STRING), v(StringV(str)) {}
+
+void StringExpr::trace() { gcMark(v); }
 
 If::If(const Expr &c, const Expr &c_t, const Expr &c_e) : ExprBase(E_IF), cond(c), conseq(c_t), alter(c_e) {}
 
+void If::trace() {
+    gcMark(cond);
+    gcMark(conseq);
+    gcMark(alter);
+}
+
 True::True() : ExprBase(E_TRUE) {}
 
 False::False() : ExprBase(E_FALSE) {}
 
 Begin::Begin(const vector<Expr> &vec) : ExprBase(E_BEGIN), es(vec) {}
 
+Begin::Begin(const vector<Expr> &vec, const vector<Sym> &names) : ExprBase(E_BEGIN), es(vec), locals(names) {}
+
+void Begin::trace() {
+    for (const auto &x : es) gcMark(x);
+}
+
 And::And(const vector<Expr> &vec) : ExprBase(E_AND), es(vec) {}
 
+void And::trace() {
+    for (const auto &x : es) gcMark(x);
+}
+
 Or::Or(const vector<Expr> &vec) : ExprBase(E_OR), es(vec) {}
 
+void Or::trace() {
+    for (const auto &x : es) gcMark(x);
+}
+
 Cond::Cond(const std::vector<std::vector<Expr>> &cls) : ExprBase(E_COND), clauses(cls) {}
 
-Quote::Quote(const Syntax &t) : ExprBase(E_QUOTE), s(t) {}
+void Cond::trace() {
+    for (const auto &clause : clauses) {
+        for (const auto &x : clause) gcMark(x);
+    }
+}
+
+Quote::Quote(const Value &datum) : ExprBase(E_QUOTE), v(datum) {}
+
+void Quote::trace() { gcMark(v); }
+
+Constant::Constant(const Value &x) : ExprBase(E_CONST), v(x) {}
+
+void Constant::trace() { gcMark(v); }
 
 MakeVoid::MakeVoid() : ExprBase(E_VOID) {}
 
 Exit::Exit() : ExprBase(E_EXIT) {}
 
-Binary::Binary(ExprType et, const Expr &r1, const Expr &r2) : ExprBase(et), rand1(r1), rand2(r2) {}
+Binary::Binary(ExprType et, const Expr &r1, const Expr &r2) : ExprBase(et, ARITY_BINARY), rand1(r1), rand2(r2) {}
+
+void Binary::trace() {
+    gcMark(rand1);
+    gcMark(rand2);
+}
 
-Unary::Unary(ExprType et, const Expr &expr) : ExprBase(et), rand(expr) {}
+Unary::Unary(ExprType et, const Expr &expr) : ExprBase(et, ARITY_UNARY), rand(expr) {}
 
-Variadic::Variadic(ExprType et, const std::vector<Expr> &rands) : ExprBase(et), rands(rands) {}
+void Unary::trace() { gcMark(rand); }
+
+Variadic::Variadic(ExprType et, const std::vector<Expr> &rands) : ExprBase(et, ARITY_VARIADIC), rands(rands) {}
+
+void Variadic::trace() {
+    for (const auto &x : rands) gcMark(x);
+}
 
 Mult::Mult(const Expr &r1, const Expr &r2) : Binary(E_MUL, r1, r2) {}
 
@@ -104,6 +174,10 @@ Modulo::Modulo(const Expr &r1, const Expr &r2) : Binary(E_MODULO, r1, r2) {}
 
 Expt::Expt(const Expr &r1, const Expr &r2) : Binary(E_EXPT, r1, r2) {}
 
+ExactToInexact::ExactToInexact(const Expr &r1) : Unary(E_EXACT_TO_INEXACT, r1) {}
+
+InexactToExact::InexactToExact(const Expr &r1) : Unary(E_INEXACT_TO_EXACT, r1) {}
+
 IsBoolean::IsBoolean(const Expr &r1) : Unary(E_BOOLQ, r1) {}
 
 IsFixnum::IsFixnum(const Expr &r1) : Unary(E_INTQ, r1) {}
@@ -126,7 +200,10 @@ Car::Car(const Expr &r1) : Unary(E_CAR, r1) {}
 
 Cdr::Cdr(const Expr &r1) : Unary(E_CDR, r1) {}
 
-Set::Set(const std::string &var, const Expr &e) : ExprBase(E_SET), var(var), e(e) {}
+Set::Set(Sym var, const Expr &e, int d, int i) : ExprBase(E_SET), var(var), e(e), depth(d), index(i),
+    global(d < 0 ? globalCell(var) : nullptr) {}
+
+void Set::trace() { gcMark(e); }
 
 SetCar::SetCar(const Expr &r1, const Expr &r2) : Binary(E_SETCAR, r1, r2) {}
 
@@ -12,25 +12,44 @@
  */
 
 #include "Def.hpp"
+#include "gc.hpp"
 #include "syntax.hpp"
 #include <memory>
 #include <cstring>
 #include <vector>
 
-struct ExprBase{
+/**
+ * @brief How a primitive node receives its operands
+ *
+ * The ExprType of a primitive does not tell this on its own: (+ a b) is a
+ * Plus while (+ a b c) is a PlusVar, and both are E_PLUS.
+ */
+enum ExprArity {
+    ARITY_NONE,         ///< Not a Unary, Binary or Variadic node
+    ARITY_UNARY,
+    ARITY_BINARY,
+    ARITY_VARIADIC
+};
+
+struct ExprBase : GCObject {
     ExprType e_type;
-    ExprBase(ExprType);
+    ExprArity arity;
+    ExprBase(ExprType, ExprArity = ARITY_NONE);
     virtual Value eval(Assoc &) = 0;
     virtual ~ExprBase() = default;
 };
 
+/**
+ * @brief Handle to a collected expression node
+ */
 class Expr {
-    std::shared_ptr<ExprBase> ptr;
+    ExprBase *ptr;
 public:
     Expr(ExprBase *);
     ExprBase* operator->() const;
     ExprBase& operator*();
     ExprBase* get() const;
+    template <class T> T *as() const;   ///< Checked downcast, nullptr if the tag differs
 };
 
 // ================================================================================
@@ -42,10 +61,12 @@ public:
  * Creates local variable bindings for expression evaluation
  */
 struct Let : ExprBase {
-    std::vector<std::pair<std::string, Expr>> bind;
+    static const ExprType tag = E_LET;
+    std::vector<std::pair<Sym, Expr>> bind;
     Expr body;
-    Let(const std::vector<std::pair<std::string, Expr>> &, const Expr &);
+    Let(const std::vector<std::pair<Sym, Expr>> &, const Expr &);
     virtual Value eval(Assoc &) override;
+    virtual void trace() override;
 };
 
 /**
@@ -53,21 +74,28 @@ struct Let : ExprBase {
  * Creates a closure with parameter list and body
  */
 struct Lambda : ExprBase {
-    std::vector<std::string> x;
+    static const ExprType tag = E_LAMBDA;
+    std::vector<Sym> x;
     Expr e;
-    Lambda(const std::vector<std::string> &, const Expr &);
+    Lambda(const std::vector<Sym> &, const Expr &);
     virtual Value eval(Assoc &) override;
+    virtual void trace() override;
 };
 
 /**
  * @brief Function application expression
- * Handles function calling where rator is operator and rand are operands
+ * Handles function calling where rator is operator and rand are operands.
+ * A call in tail position of a lambda body does not run the callee itself:
+ * it hands the call back to the trampoline of the enclosing non-tail call.
  */
 struct Apply : ExprBase {
+    static const ExprType tag = E_APPLY;
     Expr rator;
     std::vector<Expr> rand;
+    bool tail;            ///< In tail position of a lambda body (set by the parser)
     Apply(const Expr &, const std::vector<Expr> &);
     virtual Value eval(Assoc &) override;
+    virtual void trace() override;
 };
 
 /**
@@ -75,10 +103,12 @@ struct Apply : ExprBase {
  * Supports mutually recursive function definitions
  */
 struct Letrec : ExprBase {
-    std::vector<std::pair<std::string, Expr>> bind;
+    static const ExprType tag = E_LETREC;
+    std::vector<std::pair<Sym, Expr>> bind;
     Expr body;
-    Letrec(const std::vector<std::pair<std::string, Expr>> &, const Expr &);
+    Letrec(const std::vector<std::pair<Sym, Expr>> &, const Expr &);
     virtual Value eval(Assoc &) override;
+    virtual void trace() override;
 };
 
 /**
@@ -86,11 +116,13 @@ struct Letrec : ExprBase {
  * Evaluates condition and chooses between true/false branches
  */
 struct If : ExprBase {
+  static const ExprType tag = E_IF;
   Expr cond;
   Expr conseq;
   Expr alter;
   If(const Expr &, const Expr &, const Expr &);
   virtual Value eval(Assoc &) override;
+  virtual void trace() override;
 };
 
 // ================================================================================
@@ -102,10 +134,15 @@ struct If : ExprBase {
  * Defines a new variable or function in the current environment
  */
 struct Define : ExprBase {
-    std::string var;
+    static const ExprType tag = E_DEFINE;
+    Sym var;
     Expr e;
-    Define(const std::string &, const Expr &);
+    int depth;            ///< Frame depth of the body slot, -1 for a global
+    int index;            ///< Slot index within that frame
+    GlobalCell *global;   ///< Target cell of a top-level definition
+    Define(Sym, const Expr &, int, int);
     virtual Value eval(Assoc &) override;
+    virtual void trace() override;
 };
 
 /**
@@ -113,20 +150,30 @@ struct Define : ExprBase {
  * Modifies an existing variable's value
  */
 struct Set : ExprBase {
-    std::string var;
+    static const ExprType tag = E_SET;
+    Sym var;
     Expr e;
-    Set(const std::string &, const Expr &);
+    int depth;            ///< Frame depth of the binding, -1 for a global
+    int index;            ///< Slot index within that frame
+    GlobalCell *global;   ///< Resolved cell when the variable is global
+    Set(Sym, const Expr &, int, int);
     virtual Value eval(Assoc &) override;
+    virtual void trace() override;
 };
 
 /**
  * @brief Sequential execution (begin) expression
- * Evaluates expressions in order and returns the last result
+ * Evaluates expressions in order and returns the last result.
+ * Internal definitions among es are bound in a fresh frame named by locals.
  */
 struct Begin : ExprBase {
+    static const ExprType tag = E_BEGIN;
     std::vector<Expr> es;
+    std::vector<Sym> locals;
     Begin(const std::vector<Expr> &);
+    Begin(const std::vector<Expr> &, const std::vector<Sym> &);
     virtual Value eval(Assoc &) override;
+    virtual void trace() override;
 };
 
 // ================================================================================
@@ -138,9 +185,11 @@ struct Begin : ExprBase {
  * Evaluates clauses in order until one matches
  */
 struct Cond : ExprBase {
+    static const ExprType tag = E_COND;
     std::vector<std::vector<Expr>> clauses;
     Cond(const std::vector<std::vector<Expr>> &);
     virtual Value eval(Assoc &) override;
+    virtual void trace() override;
 };
 
 /**
@@ -148,9 +197,11 @@ struct Cond : ExprBase {
  * Short-circuit evaluation of boolean expressions
  */
 struct And : ExprBase {
+    static const ExprType tag = E_AND;
     std::vector<Expr> es;
     And(const std::vector<Expr> &);
     virtual Value eval(Assoc &) override;
+    virtual void trace() override;
 };
 
 /**
@@ -158,9 +209,11 @@ struct And : ExprBase {
  * Short-circuit evaluation of boolean expressions
  */
 struct Or : ExprBase {
+    static const ExprType tag = E_OR;
     std::vector<Expr> es;
     Or(const std::vector<Expr> &);
     virtual Value eval(Assoc &) override;
+    virtual void trace() override;
 };
 
 // ================================================================================
@@ -169,19 +222,37 @@ struct Or : ExprBase {
 
 /**
  * @brief Variable reference expression
- * References a variable in the current environment
+ * References a variable in the current environment. The binding is resolved
+ * at parse time to a lexical address or, for globals, to a cell.
  */
 struct Var : ExprBase {
-    std::string x;
-    Var(const std::string &);
+    static const ExprType tag = E_VAR;
+    Sym x;
+    int depth;            ///< Frames to skip in the local chain, -1 for a global
+    int index;            ///< Slot index within that frame
+    GlobalCell *global;   ///< Resolved cell when the variable is global
+    bool malformed;       ///< Whether x can never name a variable
+    Var(Sym, int, int);
     virtual Value eval(Assoc &) override;
 };
 
+/**
+ * @brief Body of the procedure the primitive x evaluates to, nullptr if
+ * it cannot be used as a value
+ */
+Expr primitiveBody(Sym x);
+
+/**
+ * @brief Preallocated procedure the primitive x evaluates to when used as a value
+ */
+Value primitiveValue(Sym x);
+
 /**
  * @brief Integer literal expression
  * Represents fixed-point numbers (integers)
  */
 struct Fixnum : ExprBase {
+  static const ExprType tag = E_FIXNUM;
   int n;
   Fixnum(int);
   virtual Value eval(Assoc &) override;
@@ -192,15 +263,18 @@ struct Fixnum : ExprBase {
  * Represents string values
  */
 struct StringExpr : ExprBase {
-  std::string s;
+  static const ExprType tag = E_STRING;
+  Value v;              ///< The string, built once and shared by every evaluation
   StringExpr(const std::string &);
   virtual Value eval(Assoc &) override;
+  virtual void trace() override;
 };
 
 /**
  * @brief Boolean true literal
  */
 struct True : ExprBase {
+  static const ExprType tag = E_TRUE;
   True();
   virtual Value eval(Assoc &) override;
 };
@@ -209,22 +283,42 @@ struct True : ExprBase {
  * @brief Boolean false literal  
  */
 struct False : ExprBase {
+  static const ExprType tag = E_FALSE;
   False();
   virtual Value eval(Assoc &) override;
 };
 
+/**
+ * @brief Quoted datum, converted from its syntax once by the parser
+ */
 struct Quote : ExprBase {
-  Syntax s;
-  Quote(const Syntax &);
+  static const ExprType tag = E_QUOTE;
+  Value v;
+  Quote(const Value &);
   virtual Value eval(Assoc &) override;
+  virtual void trace() override;
+};
+
+/**
+ * @brief Value known at parse time: a literal without a node of its own, or
+ * a primitive application folded over constant operands
+ */
+struct Constant : ExprBase {
+  static const ExprType tag = E_CONST;
+  Value v;
+  Constant(const Value &);
+  virtual Value eval(Assoc &) override;
+  virtual void trace() override;
 };
 
 struct MakeVoid : ExprBase {
+    static const ExprType tag = E_VOID;
     MakeVoid();
     virtual Value eval(Assoc &) override;
 };
 
 struct Exit : ExprBase {
+    static const ExprType tag = E_EXIT;
     Exit();
     virtual Value eval(Assoc &) override;
 };
@@ -235,6 +329,7 @@ struct Binary : ExprBase {
     Binary(ExprType, const Expr &, const Expr &);
     virtual Value evalRator(const Value &, const Value &) = 0;
     virtual Value eval(Assoc &) override;
+    virtual void trace() override;
 };
 
 struct Unary : ExprBase {
@@ -242,6 +337,7 @@ struct Unary : ExprBase {
     Unary(ExprType, const Expr &);
     virtual Value evalRator(const Value &) = 0;
     virtual Value eval(Assoc &) override;
+    virtual void trace() override;
 };
 
 struct Variadic : ExprBase {
@@ -249,6 +345,7 @@ struct Variadic : ExprBase {
     Variadic(ExprType, const std::vector<Expr> &);
     virtual Value evalRator(const std::vector<Value> &) = 0;
     virtual Value eval(Assoc &) override;
+    virtual void trace() override;
 };
 
 struct Mult : Binary {
@@ -372,6 +469,16 @@ struct Expt : Binary {
     virtual Value evalRator(const Value &, const Value &) override;
 };
 
+struct ExactToInexact : Unary {
+    ExactToInexact(const Expr &);
+    virtual Value evalRator(const Value &) override;
+};
+
+struct InexactToExact : Unary {
+    InexactToExact(const Expr &);
+    virtual Value evalRator(const Value &) override;
+};
+
 struct IsBoolean : Unary {
     IsBoolean(const Expr &);
     virtual Value evalRator(const Value &) override;
@@ -442,4 +549,21 @@ struct Display : Unary {
     virtual Value evalRator(const Value &) override;
 };
 
+// Checked downcasts: one comparison of the node's tag instead of RTTI
+template <class T> inline T *Expr::as() const {
+    return ptr->e_type == T::tag ? static_cast<T*>(ptr) : nullptr;
+}
+
+template <> inline Unary *Expr::as<Unary>() const {
+    return ptr->arity == ARITY_UNARY ? static_cast<Unary*>(ptr) : nullptr;
+}
+
+template <> inline Binary *Expr::as<Binary>() const {
+    return ptr->arity == ARITY_BINARY ? static_cast<Binary*>(ptr) : nullptr;
+}
+
+template <> inline Variadic *Expr::as<Variadic>() const {
+    return ptr->arity == ARITY_VARIADIC ? static_cast<Variadic*>(ptr) : nullptr;
+}
+
 #endif
@@ -0,0 +1,125 @@
+/**
+ * @file gc.cpp
+ * @brief Implementation of the mark-sweep garbage collector
+ */
+
+#include "gc.hpp"
+#include "value.hpp"
+#include "expr.hpp"
+#include <algorithm>
+
+// Collections are not worth running before this many objects exist
+static const size_t GC_MIN_THRESHOLD = 1 << 16;
+
+static GCObject *gc_objects = nullptr;          // every live object, newest first
+static std::vector<GCObject *> gc_mark_stack;   // grey objects still to be traced
+static std::vector<GCRootEntry> gc_permanent_roots;
+
+std::vector<GCRootEntry> gc_roots;
+size_t gc_allocated = 0;
+size_t gc_threshold = GC_MIN_THRESHOLD;
+
+// ============================================================================
+// Objects and Marking
+// ============================================================================
+
+GCObject::GCObject() : gc_next(gc_objects), gc_marked(false) {
+    gc_objects = this;
+    gc_allocated++;
+}
+
+void GCObject::trace() {}
+
+void gcMark(GCObject *obj) {
+    // An explicit stack keeps long lists and deep environments from
+    // overflowing the C++ stack
+    if (obj != nullptr && !obj->gc_marked) {
+        obj->gc_marked = true;
+        gc_mark_stack.push_back(obj);
+    }
+}
+
+void gcMark(const Value &v) {
+    if (v.isHeap()) gcMark(v.get());
+}
+
+void gcMark(const Assoc &env) {
+    gcMark(env.get());
+}
+
+void gcMark(const Expr &e) {
+    gcMark(e.get());
+}
+
+void gcMarkValueRoot(void *p) {
+    gcMark(*static_cast<Value *>(p));
+}
+
+void gcMarkAssocRoot(void *p) {
+    gcMark(*static_cast<Assoc *>(p));
+}
+
+void gcMarkExprRoot(void *p) {
+    gcMark(*static_cast<Expr *>(p));
+}
+
+void gcMarkValuesRoot(void *p) {
+    for (const Value &v : *static_cast<std::vector<Value> *>(p)) {
+        gcMark(v);
+    }
+}
+
+static void gcMarkDefinesRoot(void *p) {
+    for (const auto &def : *static_cast<std::vector<std::pair<Sym, Expr>> *>(p)) {
+        gcMark(def.second);
+    }
+}
+
+GCRoot::GCRoot(std::vector<std::pair<Sym, Expr>> &defs) {
+    gc_roots.push_back({&gcMarkDefinesRoot, &defs});
+}
+
+void gcAddPermanentRoot(void (*mark)(void *), void *p) {
+    gc_permanent_roots.push_back({mark, p});
+}
+
+// ============================================================================
+// Collection
+// ============================================================================
+
+void gcCollect() {
+    // 1. 标记：全局变量、永久根和影子根栈
+    for (GlobalCell *cell : globalCells()) {
+        gcMark(cell->v);
+    }
+    for (const GCRootEntry &root : gc_permanent_roots) {
+        root.mark(root.p);
+    }
+    for (const GCRootEntry &root : gc_roots) {
+        root.mark(root.p);
+    }
+    while (!gc_mark_stack.empty()) {
+        GCObject *obj = gc_mark_stack.back();
+        gc_mark_stack.pop_back();
+        obj->trace();
+    }
+
+    // 2. 清除：释放未标记的对象，并为下一次收集清除标记
+    size_t live = 0;
+    GCObject **link = &gc_objects;
+    while (*link != nullptr) {
+        GCObject *obj = *link;
+        if (obj->gc_marked) {
+            obj->gc_marked = false;
+            link = &obj->gc_next;
+            live++;
+        } else {
+            *link = obj->gc_next;
+            delete obj;
+        }
+    }
+
+    // 下一次收集前允许分配的对象数与存活对象数成正比
+    gc_allocated = 0;
+    gc_threshold = std::max(GC_MIN_THRESHOLD, live);
+}
@@ -0,0 +1,93 @@
+#ifndef GC_HPP
+#define GC_HPP
+
+/**
+ * @file gc.hpp
+ * @brief Precise mark-sweep garbage collector for the Scheme interpreter
+ *
+ * Heap values, environment frames and expression nodes all derive from
+ * GCObject and are reclaimed by tracing from the roots:
+ * - every global variable cell
+ * - permanent roots, such as the preallocated primitive procedures
+ * - the shadow root stack, which records the C++ locals of the evaluator
+ *   that hold objects across a call to eval (see GCRoot)
+ *
+ * Collection only happens at safepoints (procedure application and the top
+ * level of the REPL), so code between two evaluations may keep objects in
+ * unregistered locals freely.
+ */
+
+#include "Def.hpp"
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Base class of every collected object
+ */
+struct GCObject {
+    GCObject *gc_next;      ///< Next object in the list of all objects
+    bool gc_marked;         ///< Reached during the current mark phase
+    GCObject();
+    virtual void trace();   ///< Mark every object directly referenced
+    virtual ~GCObject() = default;
+};
+
+// Marking helpers used by trace() implementations
+void gcMark(GCObject *);
+void gcMark(const Value &);
+void gcMark(const Assoc &);
+void gcMark(const Expr &);
+
+/**
+ * @brief Entry of the shadow root stack
+ */
+struct GCRootEntry {
+    void (*mark)(void *);   ///< Marks everything reachable from p
+    void *p;                ///< Address of the rooted local
+};
+
+extern std::vector<GCRootEntry> gc_roots;
+extern size_t gc_allocated;     ///< Objects allocated since the last collection
+extern size_t gc_threshold;     ///< Allocation count that triggers a collection
+
+void gcMarkValueRoot(void *);
+void gcMarkAssocRoot(void *);
+void gcMarkExprRoot(void *);
+void gcMarkValuesRoot(void *);
+
+/**
+ * @brief Registers a local as a root for the lifetime of this object
+ *
+ * Roots are strictly nested, so they are kept on a stack and released in
+ * reverse order, also when a RuntimeError unwinds the evaluator.
+ */
+struct GCRoot {
+    GCRoot(Value &v) { gc_roots.push_back({&gcMarkValueRoot, &v}); }
+    GCRoot(Assoc &env) { gc_roots.push_back({&gcMarkAssocRoot, &env}); }
+    GCRoot(Expr &e) { gc_roots.push_back({&gcMarkExprRoot, &e}); }
+    GCRoot(std::vector<Value> &vs) { gc_roots.push_back({&gcMarkValuesRoot, &vs}); }
+    GCRoot(std::vector<std::pair<Sym, Expr>> &);
+    GCRoot(void (*mark)(void *), void *p) { gc_roots.push_back({mark, p}); }
+    ~GCRoot() { gc_roots.pop_back(); }
+    GCRoot(const GCRoot &) = delete;
+    GCRoot &operator=(const GCRoot &) = delete;
+};
+
+/**
+ * @brief Register a root that stays live until the program exits
+ */
+void gcAddPermanentRoot(void (*mark)(void *), void *p);
+
+/**
+ * @brief Run a full collection
+ */
+void gcCollect();
+
+/**
+ * @brief Collect if enough objects were allocated since the last collection
+ */
+inline void gcSafepoint() {
+    if (gc_allocated >= gc_threshold) gcCollect();
+}
+
+#endif // GC_HPP
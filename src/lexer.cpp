@@ -0,0 +1,217 @@
+/**
+ * @file lexer.cpp
+ * @brief Buffered and memory-mapped character source of the reader
+ */
+
+#include "lexer.hpp"
+#include "writer.hpp"
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+const size_t BLOCK_SIZE = 1 << 16;
+
+// 与原来按 isspace 判断的规则一致："C" locale 下的空白字符
+bool isBlank(unsigned char c) {
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+bool isDelimiter(unsigned char c) {
+    return isBlank(c) || c == '(' || c == ')' || c == '[' || c == ']' || c == ';';
+}
+
+#ifdef __SSE2__
+// 16 个字节中哪些是空白字符，每个字节一位
+int blankMask(__m128i c) {
+    // '\t' 到 '\r' 减去 '\t' 后落在 0..4，用无符号 min 判断范围
+    __m128i ctl = _mm_sub_epi8(c, _mm_set1_epi8('\t'));
+    __m128i hit = _mm_cmpeq_epi8(_mm_min_epu8(ctl, _mm_set1_epi8(4)), ctl);
+    hit = _mm_or_si128(hit, _mm_cmpeq_epi8(c, _mm_set1_epi8(' ')));
+    return _mm_movemask_epi8(hit);
+}
+
+int delimiterMask(__m128i c) {
+    __m128i hit = _mm_or_si128(_mm_cmpeq_epi8(c, _mm_set1_epi8('(')),
+                               _mm_cmpeq_epi8(c, _mm_set1_epi8(')')));
+    hit = _mm_or_si128(hit, _mm_cmpeq_epi8(c, _mm_set1_epi8('[')));
+    hit = _mm_or_si128(hit, _mm_cmpeq_epi8(c, _mm_set1_epi8(']')));
+    hit = _mm_or_si128(hit, _mm_cmpeq_epi8(c, _mm_set1_epi8(';')));
+    return _mm_movemask_epi8(hit) | blankMask(c);
+}
+
+int stringMask(__m128i c) {
+    __m128i hit = _mm_or_si128(_mm_cmpeq_epi8(c, _mm_set1_epi8('"')),
+                               _mm_cmpeq_epi8(c, _mm_set1_epi8('\\')));
+    return _mm_movemask_epi8(hit);
+}
+#endif
+
+// 第一个不是空白的字符，没有则返回 end
+const char *skipBlanks(const char *p, const char *end) {
+#ifdef __SSE2__
+    while (end - p >= 16) {
+        int mask = ~blankMask(_mm_loadu_si128((const __m128i *)p)) & 0xffff;
+        if (mask) return p + __builtin_ctz(mask);
+        p += 16;
+    }
+#endif
+    while (p < end && isBlank(*p)) p++;
+    return p;
+}
+
+// 第一个分隔符，没有则返回 end
+const char *findDelimiter(const char *p, const char *end) {
+#ifdef __SSE2__
+    while (end - p >= 16) {
+        int mask = delimiterMask(_mm_loadu_si128((const __m128i *)p));
+        if (mask) return p + __builtin_ctz(mask);
+        p += 16;
+    }
+#endif
+    while (p < end && !isDelimiter(*p)) p++;
+    return p;
+}
+
+// 第一个引号或反斜杠，没有则返回 end
+const char *findStringEnd(const char *p, const char *end) {
+#ifdef __SSE2__
+    while (end - p >= 16) {
+        int mask = stringMask(_mm_loadu_si128((const __m128i *)p));
+        if (mask) return p + __builtin_ctz(mask);
+        p += 16;
+    }
+#endif
+    while (p < end && *p != '"' && *p != '\\') p++;
+    return p;
+}
+
+} // namespace
+
+Lexer::Lexer(int fd) : fd(fd), buf(nullptr), cur(nullptr), end(nullptr), capacity(0), mapped(0), eof(false) {
+    struct stat st;
+    off_t offset = lseek(fd, 0, SEEK_CUR);
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && offset >= 0 && st.st_size > offset) {
+        int flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+        flags |= MAP_POPULATE;      // 一次读入整个文件，之后扫描不再缺页
+#endif
+        void *p = mmap(nullptr, st.st_size, PROT_READ, flags, fd, 0);
+        if (p != MAP_FAILED) {
+            madvise(p, st.st_size, MADV_SEQUENTIAL);
+            buf = static_cast<char *>(p);
+            mapped = st.st_size;
+            cur = buf + offset;
+            end = buf + mapped;
+            eof = true;
+            return;
+        }
+    }
+    capacity = BLOCK_SIZE;
+    buf = static_cast<char *>(malloc(capacity));
+    cur = end = buf;
+}
+
+Lexer::~Lexer() {
+    if (mapped) {
+        munmap(buf, mapped);
+    } else {
+        free(buf);
+    }
+}
+
+bool Lexer::fill() {
+    if (eof) return false;
+    // 未读完的部分移到缓冲区开头，放不下一整块时扩大缓冲区
+    size_t kept = end - cur;
+    memmove(buf, cur, kept);
+    if (capacity - kept < BLOCK_SIZE) {
+        capacity *= 2;
+        buf = static_cast<char *>(realloc(buf, capacity));
+    }
+    cur = buf;
+    end = buf + kept;
+    // 等待输入之前先把提示符等输出刷出去
+    output.flush();
+    ssize_t n;
+    do {
+        n = read(fd, buf + kept, capacity - kept);
+    } while (n < 0 && errno == EINTR);
+    if (n <= 0) {
+        eof = true;
+        return false;
+    }
+    end += n;
+    return true;
+}
+
+void Lexer::skipSpace() {
+    bool comment = false;       // 注释可能跨过缓冲区的边界，补充输入后继续找行末
+    while (true) {
+        if (cur == end && !fill()) return;
+        if (comment) {
+            // 注释一直到行末
+            const char *newline = static_cast<const char *>(memchr(cur, '\n', end - cur));
+            if (newline == nullptr) {
+                cur = end;
+                continue;
+            }
+            cur = newline + 1;
+            comment = false;
+            continue;
+        }
+        cur = skipBlanks(cur, end);
+        if (cur == end) continue;
+        if (*cur != ';') return;
+        comment = true;
+    }
+}
+
+void Lexer::token(const char *&begin, size_t &len) {
+    size_t scanned = 0;
+    while (true) {
+        const char *p = findDelimiter(cur + scanned, end);
+        scanned = p - cur;
+        // 读到缓冲区末尾时 token 可能还没结束，补充输入后从断开处继续找
+        if (p < end || !fill()) break;
+    }
+    begin = cur;
+    len = scanned;
+    cur += scanned;
+}
+
+void Lexer::string(std::string &s) {
+    while (true) {
+        const char *p = findStringEnd(cur, end);
+        s.append(cur, p);
+        cur = p;
+        if (cur == end) {
+            // 没有结束引号的字符串在输入结束处结束
+            if (!fill()) return;
+            continue;
+        }
+        if (*cur == '"') {
+            cur++;
+            return;
+        }
+        // 处理转义字符
+        cur++;
+        int next = peek();
+        if (next == EOF) return;
+        cur++;
+        switch (next) {
+            case 'n': s.push_back('\n'); break;
+            case 't': s.push_back('\t'); break;
+            case 'r': s.push_back('\r'); break;
+            default: s.push_back(next); break;
+        }
+    }
+}
@@ -0,0 +1,66 @@
+#ifndef LEXER_HPP
+#define LEXER_HPP
+
+/**
+ * @file lexer.hpp
+ * @brief Character source of the reader
+ *
+ * The input is scanned from one contiguous buffer. A regular file is
+ * mapped into memory whole; a pipe or a terminal is read in large blocks,
+ * one more each time the reader runs past the end of what it has. Runs of
+ * whitespace, token bodies and string bodies are scanned sixteen bytes at a
+ * time where SSE2 is available, and a token is handed out as a slice of the
+ * buffer instead of being copied character by character.
+ */
+
+#include <cstddef>
+#include <cstdio>
+#include <string>
+
+class Lexer {
+public:
+    explicit Lexer(int fd);     ///< Reads fd from its current offset; does not close it
+    ~Lexer();
+
+    int peek();                 ///< Next character, EOF at the end of input
+    void advance();             ///< Consume the character peek() returned
+    void skipSpace();           ///< Skip whitespace and ; comments
+
+    /**
+     * @brief Consume the characters up to the next delimiter
+     *
+     * The slice stays valid until the next call on the lexer; it is empty
+     * when the next character is already a delimiter or the input ended.
+     */
+    void token(const char *&begin, size_t &len);
+
+    /**
+     * @brief Consume a string body after its opening quote, up to and
+     * including the closing quote, resolving escapes
+     */
+    void string(std::string &);
+
+private:
+    int fd;
+    char *buf;                  ///< Start of the buffer
+    const char *cur;            ///< Next unread character
+    const char *end;            ///< End of the valid data
+    size_t capacity;            ///< Size of buf when it is read into, 0 when mapped
+    size_t mapped;              ///< Length of the mapping, 0 when read into
+    bool eof;                   ///< No more data will arrive
+
+    bool fill();                ///< Make more input available after end, false at EOF
+    Lexer(const Lexer &);
+    Lexer &operator=(const Lexer &);
+};
+
+inline int Lexer::peek() {
+    if (cur == end && !fill()) return EOF;
+    return (unsigned char)*cur;
+}
+
+inline void Lexer::advance() {
+    cur++;
+}
+
+#endif // LEXER_HPP
@@ -2,45 +2,46 @@
 #include "syntax.hpp"
 #include "expr.hpp"
 #include "value.hpp"
+#include "gc.hpp"
 #include "RE.hpp"
+#include <cstdlib>
 #include <sstream>
 #include <iostream>
 #include <map>
-
-extern std::map<std::string, ExprType> primitives;
-extern std::map<std::string, ExprType> reserved_words;
+#include <fcntl.h>
+#include <unistd.h>
 
 // 检查表达式是否是显式的 void 调用或在允许的嵌套结构中
 bool isExplicitVoidCall(Expr expr) {
     // 检查是否是直接的 MakeVoid (即 (void))
-    MakeVoid* make_void_expr = dynamic_cast<MakeVoid*>(expr.get());
+    MakeVoid* make_void_expr = expr.as<MakeVoid>();
     if (make_void_expr != nullptr) {
         return true;
     }
     
     // 检查是否是 Apply 表达式调用 void
-    Apply* apply_expr = dynamic_cast<Apply*>(expr.get());
+    Apply* apply_expr = expr.as<Apply>();
     if (apply_expr != nullptr) {
-        Var* var_expr = dynamic_cast<Var*>(apply_expr->rator.get());
-        if (var_expr != nullptr && var_expr->x == "void") {
+        Var* var_expr = apply_expr->rator.as<Var>();
+        if (var_expr != nullptr && var_expr->x->primitive == E_VOID) {
             return true;
         }
     }
     
     // 检查是否是 begin 表达式，且最后一个表达式是 void 调用
-    Begin* begin_expr = dynamic_cast<Begin*>(expr.get());
+    Begin* begin_expr = expr.as<Begin>();
     if (begin_expr != nullptr && !begin_expr->es.empty()) {
         return isExplicitVoidCall(begin_expr->es.back());
     }
     
     // 检查是否是 if 表达式的分支包含显式 void 调用
-    If* if_expr = dynamic_cast<If*>(expr.get());
+    If* if_expr = expr.as<If>();
     if (if_expr != nullptr) {
         return isExplicitVoidCall(if_expr->conseq) || isExplicitVoidCall(if_expr->alter);
     }
     
     // 检查是否是 cond 表达式的某个分支包含显式 void 调用
-    Cond* cond_expr = dynamic_cast<Cond*>(expr.get());
+    Cond* cond_expr = expr.as<Cond>();
     if (cond_expr != nullptr) {
         for (const auto& clause : cond_expr->clauses) {
             if (clause.size() > 1 && isExplicitVoidCall(clause.back())) {
@@ -52,21 +53,41 @@ bool isExplicitVoidCall(Expr expr) {
     return false;
 }
 
-void REPL(){
+/**
+ * @brief Top-level state shared by every input of one run
+ */
+struct TopLevel {
+    Assoc global_env;
+    Scope global_scope;
+    std::vector<std::pair<Sym, Expr>> pending_defines;  ///< Consecutive defines, evaluated as a group
+    TopLevel() : global_env(empty()) {}
+};
+
+/**
+ * @brief Read, evaluate and print every form of one input
+ *
+ * The prompt is only shown when interactive is set (and ONLINE_JUDGE is
+ * not defined). Returns false once (exit) is evaluated.
+ */
+bool REPL(Lexer &lexer, TopLevel &top, bool interactive){
     // read - evaluation - print loop with define grouping
-    Assoc global_env = empty();
-    std::vector<std::pair<std::string, Expr>> pending_defines;
+    std::vector<std::pair<Sym, Expr>> &pending_defines = top.pending_defines;
     
     while (1){
+        gcSafepoint();
         #ifndef ONLINE_JUDGE
-            std::cout << "scm> ";
+            if (interactive)
+                output << "scm> ";
         #endif
-        Syntax stx = readSyntax(std::cin); // read
         try{
-            Expr expr = stx->parse(global_env); // parse
+            Syntax stx = readSyntax(lexer); // read
+            if (stx.get() == nullptr)
+                return true; // 输入结束
+            Expr expr = stx->parse(top.global_scope); // parse
+            GCRoot expr_root(expr);
             
             // 检查是否是 define 表达式
-            Define* define_expr = dynamic_cast<Define*>(expr.get());
+            Define* define_expr = expr.as<Define>();
             if (define_expr != nullptr) {
                 // 收集 define 表达式
                 pending_defines.push_back({define_expr->var, define_expr->e});
@@ -76,51 +97,109 @@ void REPL(){
                 // 不是 define 表达式
                 // 如果有待处理的 define，先批量处理它们
                 if (!pending_defines.empty()) {
-                    evaluateDefineGroup(pending_defines, global_env);
+                    evaluateDefineGroup(pending_defines, top.global_env);
                     pending_defines.clear();
                 }
                 
                 // 处理当前的非 define 表达式
-                Value val = expr->eval(global_env);
-                if (val->v_type == V_TERMINATE)
-                    break;
+                Value val = evaluate(expr, top.global_env);
+                if (val.type() == V_TERMINATE)
+                    return false;
                 
                 // 简化的显示逻辑：
                 // 如果结果是 void，只有在显式调用 (void) 或在允许的嵌套结构中时才显示
-                if (val->v_type == V_VOID) {
+                if (val.type() == V_VOID) {
                     if (isExplicitVoidCall(expr)) {
-                        val->show(std::cout);
-                        puts("");
+                        val.show(output);
+                        output << '\n';
                     }
                     // 其他返回 void 的表达式不输出任何内容
                 } else {
                     // 非 void 结果正常显示
-                    val->show(std::cout);
-                    puts("");
+                    val.show(output);
+                    output << '\n';
                 }
             }
         }
         catch (const RuntimeError &RE){
             // 如果出错，清空待处理的 define
             pending_defines.clear();
-            std::cout << "RuntimeError";
-            puts("");
+            output << "RuntimeError\n";
         }
     }
-    
-    // 如果程序结束时还有待处理的 define，处理它们
-    if (!pending_defines.empty()) {
+}
+
+/**
+ * @brief Evaluate the defines still pending when the run ends
+ */
+void finish(TopLevel &top) {
+    if (!top.pending_defines.empty()) {
         try {
-            evaluateDefineGroup(pending_defines, global_env);
+            evaluateDefineGroup(top.pending_defines, top.global_env);
         } catch (const RuntimeError &RE) {
-            std::cout << "RuntimeError in final defines";
-            puts("");
+            output << "RuntimeError in final defines\n";
         }
     }
 }
 
+/**
+ * @brief Parse an option of the form <name>N with N a positive integer
+ */
+bool countOption(const std::string &arg, const std::string &name, size_t &n) {
+    if (arg.compare(0, name.size(), name) != 0) return false;
+    const char *digits = arg.c_str() + name.size();
+    char *end;
+    unsigned long long v = strtoull(digits, &end, 10);
+    if (*digits < '0' || *digits > '9' || *end != '\0' || v == 0) return false;
+    n = v;
+    return true;
+}
 
 int main(int argc, char *argv[]) {
-    REPL();
+    std::vector<std::string> scripts;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--engine=vm") {
+            engine = ENGINE_VM;
+        } else if (arg == "--engine=closure") {
+            engine = ENGINE_CLOSURE;
+        } else if (arg == "--engine=tree") {
+            engine = ENGINE_TREE;
+        } else if (countOption(arg, "--read-depth=", max_read_depth)) {
+            continue;
+        } else if (countOption(arg, "--max-depth=", max_eval_depth)) {
+            continue;
+        } else if (arg.compare(0, 2, "--") != 0) {
+            scripts.push_back(arg);
+        } else {
+            std::cerr << "usage: " << argv[0] << " [--engine=vm|closure|tree] [--read-depth=N] [--max-depth=N] [script.scm ...]" << std::endl;
+            return 1;
+        }
+    }
+    initNativeStack();
+    TopLevel top;
+    GCRoot defines_root(top.pending_defines);  // 尚未求值的 define 必须存活
+    if (scripts.empty()) {
+        Lexer lexer(STDIN_FILENO);
+        REPL(lexer, top, true);
+        finish(top);
+        output.flush();
+        return 0;
+    }
+    // 批处理模式：依次执行每个文件，共享同一个全局环境，不输出提示符
+    for (const auto &script : scripts) {
+        int fd = open(script.c_str(), O_RDONLY);
+        if (fd < 0) {
+            output.flush();
+            std::cerr << argv[0] << ": cannot open " << script << std::endl;
+            return 1;
+        }
+        Lexer lexer(fd);
+        bool more = REPL(lexer, top, false);
+        close(fd);
+        if (!more) break;
+    }
+    finish(top);
+    output.flush();
     return 0;
 }
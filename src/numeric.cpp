@@ -0,0 +1,298 @@
+/**
+ * @file numeric.cpp
+ * @brief Numeric kernels and their dispatch tables
+ *
+ * Each class of the tower is a domain struct with one static kernel per
+ * operation. A domain's kernels are only reached for operand pairs whose
+ * more general class is that domain, so the fixnum kernels see two
+ * fixnums, the bignum kernels two exact integers, the rational kernels two
+ * exact numbers and the flonum kernels two numbers at least one of which
+ * is a flonum.
+ */
+
+#include "numeric.hpp"
+#include "RE.hpp"
+#include <climits>
+#include <cmath>
+
+bool isExactInteger(const Value &v) {
+    NumClass c = numClass(v);
+    return c == NUM_FIXNUM || c == NUM_BIGNUM;
+}
+
+bool isExact(const Value &v) {
+    return numClass(v) <= NUM_RATIONAL;
+}
+
+bool isNumber(const Value &v) {
+    return numClass(v) != NUM_OTHER;
+}
+
+BigInt toBigInt(const Value &v) {
+    Bignum *b = v.as<Bignum>();
+    return b ? b->n : BigInt(v.fixnum());
+}
+
+Ratio toRatio(const Value &v) {
+    Rational *r = v.as<Rational>();
+    return r ? r->q : Ratio(toBigInt(v));
+}
+
+double toDouble(const Value &v) {
+    switch (numClass(v)) {
+        case NUM_FIXNUM: return v.fixnum();
+        case NUM_BIGNUM: return v.as<Bignum>()->n.toDouble();
+        case NUM_RATIONAL: return v.as<Rational>()->q.toDouble();
+        default: return v.as<Flonum>()->d;
+    }
+}
+
+namespace {
+
+// 只有精确的 0 作除数才报错，浮点的 0 按 IEEE 754 处理
+void checkDivisor(const Value &v) {
+    if (v == IntegerV(0)) {
+        throw(RuntimeError("Division by zero"));
+    }
+}
+
+template <class T>
+int compareResult(const T &a, const T &b) {
+    return a < b ? NUM_LT : b < a ? NUM_GT : NUM_EQ;
+}
+
+int compareResult(int c) {
+    return c < 0 ? NUM_LT : c > 0 ? NUM_GT : NUM_EQ;
+}
+
+// 两个 fixnum：在 long long 上计算，结果越出 fixnum 时由 ExactIntegerV 升级
+struct FixnumDomain {
+    static Value add(const Value &a, const Value &b) {
+        return ExactIntegerV((long long)a.fixnum() + b.fixnum());
+    }
+    static Value sub(const Value &a, const Value &b) {
+        return ExactIntegerV((long long)a.fixnum() - b.fixnum());
+    }
+    static Value mul(const Value &a, const Value &b) {
+        return ExactIntegerV((long long)a.fixnum() * b.fixnum());
+    }
+    static Value div(const Value &a, const Value &b) {
+        checkDivisor(b);
+        long long dividend = a.fixnum(), divisor = b.fixnum();
+        if (dividend % divisor == 0) {
+            return ExactIntegerV(dividend / divisor);
+        }
+        return RationalV(makeRatio(BigInt(dividend), BigInt(divisor)));
+    }
+    static Value quotient(const Value &a, const Value &b) {
+        checkDivisor(b);
+        // 向零截断的除法（C++ 的默认行为），INT_MIN / -1 会越出 fixnum
+        return ExactIntegerV((long long)a.fixnum() / b.fixnum());
+    }
+    static Value modulo(const Value &a, const Value &b) {
+        checkDivisor(b);
+        long long divisor = b.fixnum();
+        long long result = a.fixnum() % divisor;
+        // 确保结果与除数同号（除非结果为0）
+        if (result != 0 && ((result > 0) != (divisor > 0))) {
+            result += divisor;
+        }
+        return IntegerV((int)result);
+    }
+    static int compare(const Value &a, const Value &b) {
+        return compareResult(a.fixnum(), b.fixnum());
+    }
+};
+
+// 至少一方是 bignum 的精确整数
+struct BignumDomain {
+    static Value add(const Value &a, const Value &b) {
+        return ExactIntegerV(toBigInt(a) + toBigInt(b));
+    }
+    static Value sub(const Value &a, const Value &b) {
+        return ExactIntegerV(toBigInt(a) - toBigInt(b));
+    }
+    static Value mul(const Value &a, const Value &b) {
+        return ExactIntegerV(toBigInt(a) * toBigInt(b));
+    }
+    static Value div(const Value &a, const Value &b) {
+        checkDivisor(b);
+        return ExactRationalV(makeRatio(toBigInt(a), toBigInt(b)));
+    }
+    static Value quotient(const Value &a, const Value &b) {
+        checkDivisor(b);
+        BigInt q, r;
+        divmod(toBigInt(a), toBigInt(b), q, r);
+        return ExactIntegerV(q);
+    }
+    static Value modulo(const Value &a, const Value &b) {
+        checkDivisor(b);
+        BigInt divisor = toBigInt(b), q, r;
+        divmod(toBigInt(a), divisor, q, r);
+        if (!r.isZero() && r.sign() != divisor.sign()) {
+            r = r + divisor;
+        }
+        return ExactIntegerV(r);
+    }
+    static int compare(const Value &a, const Value &b) {
+        return compareResult(::compare(toBigInt(a), toBigInt(b)));
+    }
+};
+
+// 至少一方是有理数的精确数，交给有理数内核
+struct RationalDomain {
+    static Value add(const Value &a, const Value &b) {
+        return ExactRationalV(toRatio(a) + toRatio(b));
+    }
+    static Value sub(const Value &a, const Value &b) {
+        return ExactRationalV(toRatio(a) - toRatio(b));
+    }
+    static Value mul(const Value &a, const Value &b) {
+        return ExactRationalV(toRatio(a) * toRatio(b));
+    }
+    static Value div(const Value &a, const Value &b) {
+        checkDivisor(b);
+        return ExactRationalV(toRatio(a) / toRatio(b));
+    }
+    static Value quotient(const Value &, const Value &) {
+        throw(RuntimeError("Wrong typename"));
+    }
+    static Value modulo(const Value &, const Value &) {
+        throw(RuntimeError("Wrong typename"));
+    }
+    static int compare(const Value &a, const Value &b) {
+        return compareResult(::compare(toRatio(a), toRatio(b)));
+    }
+};
+
+// 有浮点数参与时直接在 double 上计算
+struct FlonumDomain {
+    static Value add(const Value &a, const Value &b) {
+        return FlonumV(toDouble(a) + toDouble(b));
+    }
+    static Value sub(const Value &a, const Value &b) {
+        return FlonumV(toDouble(a) - toDouble(b));
+    }
+    static Value mul(const Value &a, const Value &b) {
+        return FlonumV(toDouble(a) * toDouble(b));
+    }
+    static Value div(const Value &a, const Value &b) {
+        checkDivisor(b);
+        return FlonumV(toDouble(a) / toDouble(b));
+    }
+    static Value quotient(const Value &, const Value &) {
+        throw(RuntimeError("Wrong typename"));
+    }
+    static Value modulo(const Value &, const Value &) {
+        throw(RuntimeError("Wrong typename"));
+    }
+    static int compare(const Value &a, const Value &b) {
+        if (fitsDouble(a) && fitsDouble(b)) {
+            double x = toDouble(a), y = toDouble(b);
+            // NaN 与任何数都不可比较
+            return x < y ? NUM_LT : x > y ? NUM_GT : x == y ? NUM_EQ : NUM_UNORDERED;
+        }
+        // 精确数转成 double 会舍入，比较结果要与精确比较一致，否则 = 和 <
+        // 失去传递性：把有限的浮点数转成精确值再比较
+        bool flonum_first = numClass(a) == NUM_FLONUM;
+        double d = (flonum_first ? a : b).as<Flonum>()->d;
+        if (std::isnan(d)) return NUM_UNORDERED;
+        if (std::isinf(d)) {
+            return (d > 0) == flonum_first ? NUM_GT : NUM_LT;
+        }
+        return flonum_first ? compareResult(::compare(exactRatio(d), toRatio(b)))
+                            : compareResult(::compare(toRatio(a), exactRatio(d)));
+    }
+
+private:
+    // 转成 double 不会舍入：浮点数本身、fixnum 和绝对值不超过 2^53 的 bignum
+    static bool fitsDouble(const Value &v) {
+        switch (numClass(v)) {
+            case NUM_FLONUM:
+            case NUM_FIXNUM: return true;
+            case NUM_BIGNUM: {
+                const BigInt &n = v.as<Bignum>()->n;
+                if (!n.fitsLong()) return false;
+                long long m = n.toLong();
+                return m >= -(1LL << 53) && m <= (1LL << 53);
+            }
+            default: return false;
+        }
+    }
+};
+
+// 至少一方不是数
+struct OtherDomain {
+#define NUMERIC_TYPE_ERROR(op, kernel) \
+    static Value kernel(const Value &, const Value &) { \
+        throw(RuntimeError("Wrong typename")); \
+    }
+    NUMERIC_OPS(NUMERIC_TYPE_ERROR)
+#undef NUMERIC_TYPE_ERROR
+    static int compare(const Value &, const Value &) {
+        throw(RuntimeError("Wrong typename"));
+    }
+};
+
+// 一对操作数在两者中更一般的那一类里运算
+constexpr NumClass join(NumClass a, NumClass b) {
+    return a == NUM_OTHER || b == NUM_OTHER ? NUM_OTHER : a > b ? a : b;
+}
+
+template <class D>
+constexpr NumKernel domainKernel(NumOp op) {
+#define NUMERIC_SELECT(o, kernel) op == o ? &D::kernel :
+    return NUMERIC_OPS(NUMERIC_SELECT) nullptr;
+#undef NUMERIC_SELECT
+}
+
+constexpr NumKernel kernel(NumOp op, NumClass c) {
+    return c == NUM_FIXNUM ? domainKernel<FixnumDomain>(op)
+         : c == NUM_BIGNUM ? domainKernel<BignumDomain>(op)
+         : c == NUM_RATIONAL ? domainKernel<RationalDomain>(op)
+         : c == NUM_FLONUM ? domainKernel<FlonumDomain>(op)
+         : domainKernel<OtherDomain>(op);
+}
+
+constexpr CompareKernel comparator(NumClass c) {
+    return c == NUM_FIXNUM ? &FixnumDomain::compare
+         : c == NUM_BIGNUM ? &BignumDomain::compare
+         : c == NUM_RATIONAL ? &RationalDomain::compare
+         : c == NUM_FLONUM ? &FlonumDomain::compare
+         : &OtherDomain::compare;
+}
+
+} // namespace
+
+#define NUMERIC_ROW(op, c) { \
+    kernel(op, join(c, NUM_FIXNUM)), \
+    kernel(op, join(c, NUM_BIGNUM)), \
+    kernel(op, join(c, NUM_RATIONAL)), \
+    kernel(op, join(c, NUM_FLONUM)), \
+    kernel(op, NUM_OTHER) }
+
+#define NUMERIC_TABLE(op, k) { \
+    NUMERIC_ROW(op, NUM_FIXNUM), \
+    NUMERIC_ROW(op, NUM_BIGNUM), \
+    NUMERIC_ROW(op, NUM_RATIONAL), \
+    NUMERIC_ROW(op, NUM_FLONUM), \
+    NUMERIC_ROW(op, NUM_OTHER) },
+
+const NumKernel numericTable[NUM_OPS][NUM_CLASSES][NUM_CLASSES] = {
+    NUMERIC_OPS(NUMERIC_TABLE)
+};
+
+#define COMPARE_ROW(c) { \
+    comparator(join(c, NUM_FIXNUM)), \
+    comparator(join(c, NUM_BIGNUM)), \
+    comparator(join(c, NUM_RATIONAL)), \
+    comparator(join(c, NUM_FLONUM)), \
+    comparator(NUM_OTHER) }
+
+const CompareKernel compareTable[NUM_CLASSES][NUM_CLASSES] = {
+    COMPARE_ROW(NUM_FIXNUM),
+    COMPARE_ROW(NUM_BIGNUM),
+    COMPARE_ROW(NUM_RATIONAL),
+    COMPARE_ROW(NUM_FLONUM),
+    COMPARE_ROW(NUM_OTHER)
+};
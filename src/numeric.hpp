@@ -0,0 +1,98 @@
+#ifndef NUMERIC_HPP
+#define NUMERIC_HPP
+
+/**
+ * @file numeric.hpp
+ * @brief Numeric tower and the dispatch tables of the arithmetic primitives
+ *
+ * Every number belongs to one class of the tower, ordered by generality:
+ * fixnum < bignum < rational < flonum. An operation on two numbers runs in
+ * the more general of their two classes, so each class supplies a single
+ * kernel per operation that may assume both operands are at most that
+ * general. The kernel for a pair of operands is found by indexing a table
+ * with their classes; non-numbers index a column whose kernels raise the
+ * type error.
+ *
+ * Adding a numeric class means one more column of kernels; the binary and
+ * variadic primitive nodes need no change.
+ */
+
+#include "value.hpp"
+
+enum NumClass {
+    NUM_FIXNUM,
+    NUM_BIGNUM,
+    NUM_RATIONAL,
+    NUM_FLONUM,
+    NUM_OTHER,          ///< Not a number
+    NUM_CLASSES
+};
+
+/**
+ * @brief Binary numeric operations, with the kernel name each class provides
+ */
+#define NUMERIC_OPS(X) \
+    X(NUM_ADD, add) \
+    X(NUM_SUB, sub) \
+    X(NUM_MUL, mul) \
+    X(NUM_DIV, div) \
+    X(NUM_QUOTIENT, quotient) \
+    X(NUM_MODULO, modulo)
+
+enum NumOp {
+#define NUMERIC_ENUM(op, kernel) op,
+    NUMERIC_OPS(NUMERIC_ENUM)
+#undef NUMERIC_ENUM
+    NUM_OPS
+};
+
+/**
+ * @brief Outcome of comparing two numbers, as a bit set so that each
+ * comparison primitive tests for the outcomes it accepts; NaN is unordered
+ */
+enum {
+    NUM_UNORDERED = 0,
+    NUM_LT = 1,
+    NUM_EQ = 2,
+    NUM_GT = 4
+};
+
+typedef Value (*NumKernel)(const Value &, const Value &);
+typedef int (*CompareKernel)(const Value &, const Value &);
+
+extern const NumKernel numericTable[NUM_OPS][NUM_CLASSES][NUM_CLASSES];
+extern const CompareKernel compareTable[NUM_CLASSES][NUM_CLASSES];
+
+bool isExactInteger(const Value &);     ///< Fixnum or bignum
+bool isExact(const Value &);            ///< Exact integer or rational
+bool isNumber(const Value &);
+BigInt toBigInt(const Value &);         ///< Exact integer as a BigInt
+Ratio toRatio(const Value &);           ///< Exact number as a Ratio
+double toDouble(const Value &);         ///< Any number as a double
+
+inline NumClass numClass(const Value &v) {
+    if (v.bits & 1) return NUM_FIXNUM;
+    if (!v.isHeap()) return NUM_OTHER;
+    switch (v->v_type) {
+        case V_BIGNUM: return NUM_BIGNUM;
+        case V_RATIONAL: return NUM_RATIONAL;
+        case V_FLONUM: return NUM_FLONUM;
+        default: return NUM_OTHER;
+    }
+}
+
+/**
+ * @brief Apply a binary numeric operation
+ */
+inline Value numericOp(NumOp op, const Value &a, const Value &b) {
+    return numericTable[op][numClass(a)][numClass(b)](a, b);
+}
+
+/**
+ * @brief Compare two numbers: NUM_LT, NUM_EQ, NUM_GT or NUM_UNORDERED
+ */
+inline int numericCompare(const Value &a, const Value &b) {
+    return compareTable[numClass(a)][numClass(b)](a, b);
+}
+
+#endif // NUMERIC_HPP
@@ -12,7 +12,9 @@
 #include "syntax.hpp"
 #include "value.hpp"
 #include "expr.hpp"
+#include "numeric.hpp"
 #include <map>
+#include <memory>
 #include <string>
 #include <iostream>
 
@@ -21,9 +23,6 @@ using std::string;
 using std::vector;
 using std::pair;
 
-extern std::map<std::string, ExprType> primitives;
-extern std::map<std::string, ExprType> reserved_words;
-
 // ============================================================================
 // Base Syntax Parsing Methods
 // ============================================================================
@@ -31,360 +30,813 @@ extern std::map<std::string, ExprType> reserved_words;
 /**
  * @brief Default parse method (should be overridden by subclasses)
  */
-Expr Syntax::parse(Assoc &env) {
+Expr Syntax::parse(Scope &env) {
     throw RuntimeError("Unimplemented parse method");
 }
 
 /**
  * @brief Parse a numeric literal
  */
-Expr Number::parse(Assoc &env) {
+Expr Number::parse(Scope &env) {
     return Expr(new Fixnum(n));
 }
 
+// 大整数和浮点数字面量没有专门的节点，值在解析时就构造好
+Expr BigNumber::parse(Scope &env) {
+    return Expr(new Constant(BignumV(n)));
+}
+
+Expr FlonumSyntax::parse(Scope &env) {
+    return Expr(new Constant(FlonumV(d)));
+}
+
 /**
  * @brief Parse a symbol (variable reference)
+ * The variable is resolved against the scope chain right away.
  */
-Expr SymbolSyntax::parse(Assoc &env) {
-    return Expr(new Var(s));
+Expr SymbolSyntax::parse(Scope &env) {
+    int depth = -1, index = 0;
+    env.lookup(s, depth, index);
+    return Expr(new Var(s, depth, index));
 }
 
 /**
  * @brief Parse a string literal
  */
-Expr StringSyntax::parse(Assoc &env) {
+Expr StringSyntax::parse(Scope &env) {
     return Expr(new StringExpr(s));
 }
 
 /**
  * @brief Parse boolean true literal
  */
-Expr TrueSyntax::parse(Assoc &env) {
+Expr TrueSyntax::parse(Scope &env) {
     return Expr(new True());
 }
 
 /**
  * @brief Parse boolean false literal
  */
-Expr FalseSyntax::parse(Assoc &env) {
+Expr FalseSyntax::parse(Scope &env) {
     return Expr(new False());
 }
 
-Expr List::parse(Assoc &env) {
-    if (stxs.empty()) {
-        // 空列表 () 应该解析为一个引用的空列表，求值为 null
-        return Expr(new Quote(Syntax(new List())));
+// 是否为点对记法中的 "."
+static bool isDot(const Syntax &s) {
+    static Sym dot = intern(".");
+    SymbolSyntax *sym = s.as<SymbolSyntax>();
+    return sym != nullptr && sym->s == dot;
+}
+
+/**
+ * @brief Datum of quoted syntax that is not a list
+ */
+static Value atomDatum(const Syntax &s) {
+    switch (s->s_type) {
+        case S_TRUE: return BooleanV(true);
+        case S_FALSE: return BooleanV(false);
+        case S_NUMBER: return IntegerV(static_cast<Number*>(s.get())->n);
+        case S_BIGNUM: return BignumV(static_cast<BigNumber*>(s.get())->n);
+        case S_FLONUM: return FlonumV(static_cast<FlonumSyntax*>(s.get())->d);
+        case S_SYMBOL: return SymbolV(static_cast<SymbolSyntax*>(s.get())->s);
+        case S_STRING: return StringV(static_cast<StringSyntax*>(s.get())->s);
+        default: throw(RuntimeError("Unknown quoted typename"));
     }
+}
+
+/**
+ * @brief A quoted list whose pairs are being built
+ *
+ * The elements are converted from the last one backwards, consing each
+ * onto datum; tail is set while the element at next is the one after a dot.
+ */
+struct QuotedList {
+    const SyntaxList *stxs;
+    int next;
+    bool tail;
+    Value datum;
+};
 
-    // 检查第一个元素是否为 SymbolSyntax
-    SymbolSyntax *id = dynamic_cast<SymbolSyntax*>(stxs[0].get());
-    if (id == nullptr) {
-        // 如果不是 SymbolSyntax，则将其解析为表达式并构造 Apply 表达式
-        vector<Expr> parameters;
-        for (size_t i = 1; i < stxs.size(); i++) {
-            parameters.push_back(stxs[i]->parse(env));
+// 检查点对记法，返回从最后一个元素开始构造的状态
+static QuotedList openQuoted(const List *list) {
+    const SyntaxList &stxs = list->stxs;
+    int pos = -1, cnt = 0, len = stxs.size();
+    // 单个元素的 (.) 里的点只是一个符号
+    for (int i = 0; len > 1 && i < len; i++) {
+        if (isDot(stxs[i])) {
+            pos = i;
+            cnt++;
+        }
+    }
+    if (cnt > 1 || (cnt == 1 && (pos != len - 2 || len < 3))) {
+        throw RuntimeError("Parm isn't fit");
+    }
+    return QuotedList{&stxs, len - 1, cnt == 1, NullV()};
+}
+
+/**
+ * @brief Convert quoted syntax into the datum it denotes
+ *
+ * This runs once per quote form, and every evaluation of the form returns
+ * the same datum, so its pairs are marked immutable. Each list is built from
+ * its last element backwards, and nested lists wait on an explicit stack,
+ * so any nesting depth converts in a single pass.
+ */
+static Value quoteDatum(const Syntax &s) {
+    List *list = s.as<List>();
+    if (list == nullptr) return atomDatum(s);
+    vector<QuotedList> open(1, openQuoted(list));
+    while (true) {
+        QuotedList &top = open.back();
+        Value element(nullptr);
+        if (top.next < 0) {
+            // 这个表构造完了，交给外层
+            element = top.datum;
+            open.pop_back();
+            if (open.empty()) return element;
+        } else {
+            const Syntax &stx = (*top.stxs)[top.next];
+            List *sublist = stx.as<List>();
+            if (sublist != nullptr) {
+                open.push_back(openQuoted(sublist));
+                continue;
+            }
+            element = atomDatum(stx);
         }
-        return Expr(new Apply(stxs[0]->parse(env), parameters));
-    }else{
-    string op = id->s;
-    if (find(op, env).get() != nullptr) {
-         vector<Expr> parameters;
-        for (size_t i = 1; i < stxs.size(); i++) {
-            parameters.push_back(stxs[i].get()->parse(env));
+        QuotedList &outer = open.back();
+        if (outer.tail) {
+            outer.datum = element;
+            outer.tail = false;
+            outer.next -= 2;    // 跳过点
+        } else {
+            outer.datum = PairV(element, outer.datum);
+            outer.datum->immutable = true;
+            outer.next--;
         }
-        return Expr(new Apply(stxs[0].get()->parse(env), parameters));
     }
-    // 检查是否为库函数
-    if (primitives.count(op) != 0) {
-        vector<Expr> parameters;
-        for (int i = 1; i < stxs.size(); i++) {
-            parameters.push_back(stxs[i].get()->parse(env));
+}
+
+/**
+ * @brief Whether name is bound by some local scope, shadowing primitives and reserved words
+ */
+static bool isLocal(Sym name, Scope &env) {
+    int depth, index;
+    return env.lookup(name, depth, index);
+}
+
+/**
+ * @brief Name bound by an internal definition form, or nullptr if stx is not one
+ */
+static Sym definedName(const Syntax &stx, Scope &env) {
+    List *form = stx.as<List>();
+    if (form == nullptr || form->stxs.size() < 3) return nullptr;
+    SymbolSyntax *head = form->stxs[0].as<SymbolSyntax>();
+    if (head == nullptr || head->s->reserved != E_DEFINE || isLocal(head->s, env)) return nullptr;
+    SymbolSyntax *name = form->stxs[1].as<SymbolSyntax>();
+    if (name == nullptr) {
+        List *header = form->stxs[1].as<List>();
+        if (header != nullptr && !header->stxs.empty()) {
+            name = header->stxs[0].as<SymbolSyntax>();
         }
-        
-        // 特殊处理多参数算术运算符
-        ExprType op_type = primitives[op];
-        if (op_type == E_PLUS) {
-            if (parameters.size() == 0) {
-                return Expr(new PlusVar(parameters)); // (+ ) → 0
-            } else if (parameters.size() == 1) {
-                return parameters[0]; // (+ x) → x
-            } else if (parameters.size() == 2) {
-                return Expr(new Plus(parameters[0], parameters[1])); // 保持二元兼容
-            } else {
-                return Expr(new PlusVar(parameters)); // 多参数
+    }
+    return name == nullptr ? nullptr : name->s;
+}
+
+/**
+ * @brief Build a Define, resolving the slot it assigns to
+ *
+ * In the global scope the definition is global. Elsewhere it must be one of
+ * the internal definitions parseBody reserved a slot for.
+ */
+static Expr makeDefine(Sym name, const Expr &e, Scope &env) {
+    int depth = -1, index = 0;
+    if (!env.isGlobal() && !env.lookup(name, depth, index)) {
+        throw RuntimeError("define is only allowed at the beginning of a body: " + name->name);
+    }
+    return Expr(new Define(name, e, depth, index));
+}
+
+/**
+ * @brief Flag the calls in tail position of a lambda body
+ *
+ * Tail positions are followed through if, begin, cond, and, or, let and
+ * letrec; a call found there is run by the trampoline of its caller.
+ */
+static void markTailCalls(const Expr &body) {
+    vector<Expr> pending(1, body);
+    while (!pending.empty()) {
+        Expr e = pending.back();
+        pending.pop_back();
+        switch (e->e_type) {
+            case E_APPLY:
+                static_cast<Apply*>(e.get())->tail = true;
+                break;
+            case E_IF: {
+                If *if_expr = static_cast<If*>(e.get());
+                pending.push_back(if_expr->conseq);
+                pending.push_back(if_expr->alter);
+                break;
             }
-        } else if (op_type == E_MUL) {
-            if (parameters.size() == 0) {
-                return Expr(new MultVar(parameters)); // (* ) → 1
-            } else if (parameters.size() == 1) {
-                return parameters[0]; // (* x) → x
-            } else if (parameters.size() == 2) {
-                return Expr(new Mult(parameters[0], parameters[1])); // 保持二元兼容
-            } else {
-                return Expr(new MultVar(parameters)); // 多参数
+            case E_BEGIN: {
+                Begin *begin = static_cast<Begin*>(e.get());
+                if (!begin->es.empty()) pending.push_back(begin->es.back());
+                break;
             }
-        } else if (op_type == E_MINUS) {
-            if (parameters.size() == 0) {
-                throw RuntimeError("Wrong number of arguments for -");
-            } else if (parameters.size() == 1) {
-                return Expr(new MinusVar(parameters)); // (- x) → -x
-            } else if (parameters.size() == 2) {
-                return Expr(new Minus(parameters[0], parameters[1])); // 保持二元兼容
-            } else {
-                return Expr(new MinusVar(parameters)); // 多参数
+            case E_AND: {
+                And *and_expr = static_cast<And*>(e.get());
+                if (!and_expr->es.empty()) pending.push_back(and_expr->es.back());
+                break;
             }
-        } else if (op_type == E_DIV) {
-            if (parameters.size() == 0) {
-                throw RuntimeError("Wrong number of arguments for /");
-            } else if (parameters.size() == 1) {
-                return Expr(new DivVar(parameters)); // (/ x) → 1/x
-            } else if (parameters.size() == 2) {
-                return Expr(new Div(parameters[0], parameters[1])); // 保持二元兼容
-            } else {
-                return Expr(new DivVar(parameters)); // 多参数
+            case E_OR: {
+                Or *or_expr = static_cast<Or*>(e.get());
+                if (!or_expr->es.empty()) pending.push_back(or_expr->es.back());
+                break;
             }
-        } else if (op_type == E_LIST) {
-            // list 函数：接受任意数量的参数
-            return Expr(new ListFunc(parameters));
-        } else if (op_type == E_LT) {
-            // < 比较操作符
-            if (parameters.size() < 2) {
-                throw RuntimeError("Wrong number of arguments for <");
-            } else if (parameters.size() == 2) {
-                return Expr(new Less(parameters[0], parameters[1])); // 保持二元兼容
-            } else {
-                return Expr(new LessVar(parameters)); // 多参数
+            case E_COND:
+                for (const auto &clause : static_cast<Cond*>(e.get())->clauses) {
+                    if (clause.size() > 1) pending.push_back(clause.back());
+                }
+                break;
+            case E_LET:
+                pending.push_back(static_cast<Let*>(e.get())->body);
+                break;
+            case E_LETREC:
+                pending.push_back(static_cast<Letrec*>(e.get())->body);
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+/**
+ * @brief Node for a call to the primitive op that is not shadowed in env
+ */
+static Expr makePrimitiveCall(Sym op, const vector<Expr> &parameters, const Syntax &head, Scope &env) {
+    // 特殊处理多参数算术运算符
+    ExprType op_type = ExprType(op->primitive);
+    if (op_type == E_PLUS) {
+        if (parameters.size() == 0) {
+            return Expr(new PlusVar(parameters)); // (+ ) → 0
+        } else if (parameters.size() == 1) {
+            return parameters[0]; // (+ x) → x
+        } else if (parameters.size() == 2) {
+            return Expr(new Plus(parameters[0], parameters[1])); // 保持二元兼容
+        } else {
+            return Expr(new PlusVar(parameters)); // 多参数
+        }
+    } else if (op_type == E_MUL) {
+        if (parameters.size() == 0) {
+            return Expr(new MultVar(parameters)); // (* ) → 1
+        } else if (parameters.size() == 1) {
+            return parameters[0]; // (* x) → x
+        } else if (parameters.size() == 2) {
+            return Expr(new Mult(parameters[0], parameters[1])); // 保持二元兼容
+        } else {
+            return Expr(new MultVar(parameters)); // 多参数
+        }
+    } else if (op_type == E_MINUS) {
+        if (parameters.size() == 0) {
+            throw RuntimeError("Wrong number of arguments for -");
+        } else if (parameters.size() == 1) {
+            return Expr(new MinusVar(parameters)); // (- x) → -x
+        } else if (parameters.size() == 2) {
+            return Expr(new Minus(parameters[0], parameters[1])); // 保持二元兼容
+        } else {
+            return Expr(new MinusVar(parameters)); // 多参数
+        }
+    } else if (op_type == E_DIV) {
+        if (parameters.size() == 0) {
+            throw RuntimeError("Wrong number of arguments for /");
+        } else if (parameters.size() == 1) {
+            return Expr(new DivVar(parameters)); // (/ x) → 1/x
+        } else if (parameters.size() == 2) {
+            return Expr(new Div(parameters[0], parameters[1])); // 保持二元兼容
+        } else {
+            return Expr(new DivVar(parameters)); // 多参数
+        }
+    } else if (op_type == E_LIST) {
+        // list 函数：接受任意数量的参数
+        return Expr(new ListFunc(parameters));
+    } else if (op_type == E_LT) {
+        // < 比较操作符
+        if (parameters.size() < 2) {
+            throw RuntimeError("Wrong number of arguments for <");
+        } else if (parameters.size() == 2) {
+            return Expr(new Less(parameters[0], parameters[1])); // 保持二元兼容
+        } else {
+            return Expr(new LessVar(parameters)); // 多参数
+        }
+    } else if (op_type == E_LE) {
+        // <= 比较操作符
+        if (parameters.size() < 2) {
+            throw RuntimeError("Wrong number of arguments for <=");
+        } else if (parameters.size() == 2) {
+            return Expr(new LessEq(parameters[0], parameters[1])); // 保持二元兼容
+        } else {
+            return Expr(new LessEqVar(parameters)); // 多参数
+        }
+    } else if (op_type == E_EQ) {
+        // = 比较操作符
+        if (parameters.size() < 2) {
+            throw RuntimeError("Wrong number of arguments for =");
+        } else if (parameters.size() == 2) {
+            return Expr(new Equal(parameters[0], parameters[1])); // 保持二元兼容
+        } else {
+            return Expr(new EqualVar(parameters)); // 多参数
+        }
+    } else if (op_type == E_GE) {
+        // >= 比较操作符
+        if (parameters.size() < 2) {
+            throw RuntimeError("Wrong number of arguments for >=");
+        } else if (parameters.size() == 2) {
+            return Expr(new GreaterEq(parameters[0], parameters[1])); // 保持二元兼容
+        } else {
+            return Expr(new GreaterEqVar(parameters)); // 多参数
+        }
+    } else if (op_type == E_GT) {
+        // > 比较操作符
+        if (parameters.size() < 2) {
+            throw RuntimeError("Wrong number of arguments for >");
+        } else if (parameters.size() == 2) {
+            return Expr(new Greater(parameters[0], parameters[1])); // 保持二元兼容
+        } else {
+            return Expr(new GreaterVar(parameters)); // 多参数
+        }
+    } else {
+        // 其他原语保持原来的处理方式
+        return new Apply(head->parse(env), parameters);
+    }
+}
+
+/**
+ * @brief Value of e if it is a constant, or nullptr
+ */
+static Value constantValue(const Expr &e) {
+    switch (e->e_type) {
+        case E_FIXNUM: return IntegerV(static_cast<Fixnum*>(e.get())->n);
+        case E_TRUE: return BooleanV(true);
+        case E_FALSE: return BooleanV(false);
+        case E_STRING: return static_cast<StringExpr*>(e.get())->v;
+        case E_CONST: return static_cast<Constant*>(e.get())->v;
+        case E_QUOTE: return static_cast<Quote*>(e.get())->v;
+        default: return Value(nullptr);
+    }
+}
+
+/**
+ * @brief Primitives whose result depends only on their arguments and that
+ * neither allocate mutable data nor have side effects
+ */
+static bool isFoldable(int primitive) {
+    switch (primitive) {
+        case E_PLUS: case E_MINUS: case E_MUL: case E_DIV:
+        case E_QUOTIENT: case E_MODULO: case E_EXPT:
+        case E_EXACT_TO_INEXACT: case E_INEXACT_TO_EXACT:
+        case E_LT: case E_LE: case E_EQ: case E_GE: case E_GT:
+        case E_EQQ: case E_BOOLQ: case E_INTQ: case E_NULLQ: case E_PAIRQ:
+        case E_PROCQ: case E_SYMBOLQ: case E_LISTQ: case E_NUMBERQ: case E_STRINGQ:
+        case E_NOT:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief Largest bignum, in limbs, that folding takes as an operand or
+ * produces as a result
+ */
+static const size_t FOLD_LIMBS = 4;
+
+static bool isSmallInteger(const BigInt &n) {
+    return n.mag.size() <= FOLD_LIMBS;
+}
+
+/**
+ * @brief Whether v is small enough to be computed with and kept at parse time
+ */
+static bool isSmallConstant(const Value &v) {
+    if (Bignum *b = v.as<Bignum>()) return isSmallInteger(b->n);
+    if (Rational *r = v.as<Rational>()) return isSmallInteger(r->q.num) && isSmallInteger(r->q.den);
+    return true;
+}
+
+/**
+ * @brief Whether an exact expt could outgrow FOLD_LIMBS
+ *
+ * The result has at most as many bits as the base times the exponent, so
+ * a large power is recognised before any of it is computed.
+ */
+static bool isLargePower(const Value &base, const Value &exponent) {
+    if (!isExactInteger(base) || exponent.type() != V_INT || exponent.fixnum() <= 0) return false;
+    long long bits = (long long)toBigInt(base).bitLength() * exponent.fixnum();
+    return bits > (long long)FOLD_LIMBS * 32;
+}
+
+/**
+ * @brief Node holding a value computed at parse time
+ */
+static Expr literal(const Value &v) {
+    if (v.type() == V_INT) return Expr(new Fixnum(v.fixnum()));
+    if (v.type() == V_BOOL) return v == BooleanV(true) ? Expr(new True()) : Expr(new False());
+    return Expr(new Constant(v));
+}
+
+/**
+ * @brief Fold a primitive call whose operands are all constants
+ *
+ * Only calls to primitives that are not shadowed reach here, and global
+ * primitives can be neither redefined nor assigned, so the call means the
+ * same every time it runs. A call that raises an error is left alone: the
+ * error belongs to its evaluation, which may never happen.
+ */
+static Expr foldConstants(const Expr &e) {
+    vector<Value> args;
+    Value proc(nullptr);
+    switch (e->arity) {
+        case ARITY_UNARY:
+            args.push_back(constantValue(static_cast<Unary*>(e.get())->rand));
+            break;
+        case ARITY_BINARY:
+            args.push_back(constantValue(static_cast<Binary*>(e.get())->rand1));
+            args.push_back(constantValue(static_cast<Binary*>(e.get())->rand2));
+            break;
+        case ARITY_VARIADIC:
+            for (const auto &r : static_cast<Variadic*>(e.get())->rands) {
+                args.push_back(constantValue(r));
             }
-        } else if (op_type == E_LE) {
-            // <= 比较操作符
-            if (parameters.size() < 2) {
-                throw RuntimeError("Wrong number of arguments for <=");
-            } else if (parameters.size() == 2) {
-                return Expr(new LessEq(parameters[0], parameters[1])); // 保持二元兼容
-            } else {
-                return Expr(new LessEqVar(parameters)); // 多参数
+            break;
+        default: {
+            Apply *call = e.as<Apply>();
+            if (call == nullptr) return e;
+            Var *var = call->rator.as<Var>();
+            if (var == nullptr || var->malformed || var->depth >= 0 || var->x->primitive < 0) return e;
+            proc = primitiveValue(var->x);
+            for (const auto &r : call->rand) {
+                args.push_back(constantValue(r));
             }
-        } else if (op_type == E_EQ) {
-            // = 比较操作符
-            if (parameters.size() < 2) {
-                throw RuntimeError("Wrong number of arguments for =");
-            } else if (parameters.size() == 2) {
-                return Expr(new Equal(parameters[0], parameters[1])); // 保持二元兼容
-            } else {
-                return Expr(new EqualVar(parameters)); // 多参数
+            break;
+        }
+    }
+    int primitive = proc.isUnbound() ? e->e_type : proc.as<Primitive>()->body->e_type;
+    if (!isFoldable(primitive)) return e;
+    for (const auto &v : args) {
+        if (v.isUnbound() || !isSmallConstant(v)) return e;
+    }
+    // 折叠的代价在解析时就要付出，即使这段代码从不执行，所以不折叠大数
+    if (primitive == E_EXPT && args.size() == 2 && isLargePower(args[0], args[1])) return e;
+    Value v(nullptr);
+    try {
+        switch (e->arity) {
+            case ARITY_UNARY: v = static_cast<Unary*>(e.get())->evalRator(args[0]); break;
+            case ARITY_BINARY: v = static_cast<Binary*>(e.get())->evalRator(args[0], args[1]); break;
+            case ARITY_VARIADIC: v = static_cast<Variadic*>(e.get())->evalRator(args); break;
+            default: v = proc.as<Primitive>()->apply(args.data(), args.size()); break;
+        }
+    } catch (const RuntimeError &) {
+        return e;
+    }
+    return isSmallConstant(v) ? literal(v) : e;
+}
+
+/**
+ * @brief Kind of node a pending form builds
+ */
+enum FormKind {
+    FORM_APPLY,         ///< Procedure call: operator, then operands
+    FORM_PRIMITIVE,     ///< Call to the primitive op: operands
+    FORM_IF,
+    FORM_AND,
+    FORM_OR,
+    FORM_BEGIN,         ///< Body
+    FORM_COND,          ///< Clause forms, counts holds the length of each clause
+    FORM_LET,           ///< Bound expressions, then body
+    FORM_LETREC,        ///< Bound expressions, then body
+    FORM_LAMBDA,        ///< Body
+    FORM_DEFINE,        ///< Value expression
+    FORM_DEFINE_LAMBDA, ///< Body of (define (op names...) body...)
+    FORM_SET            ///< Value expression
+};
+
+/**
+ * @brief A list form waiting for its subforms to be parsed
+ *
+ * Parsing a list takes two steps. planForm checks the shape of the form and
+ * lists the subforms to parse, each with the scope it is parsed in, and
+ * opens the scopes the form introduces; buildForm assembles the node once
+ * every subform is parsed. In between the form waits on an explicit stack,
+ * so the nesting depth of a program costs heap memory, not native stack.
+ */
+struct PendingForm {
+    List *form;
+    Scope *env;                                     ///< Scope of the form itself
+    FormKind kind;
+    Sym op;                                         ///< Primitive called, or variable defined or set
+    vector<pair<const Syntax *, Scope *>> subforms; ///< What to parse, in order
+    vector<Expr> parsed;                            ///< Nodes of subforms[0 .. parsed.size())
+    vector<Sym> names;                              ///< Names bound by let, letrec or lambda
+    vector<size_t> counts;                          ///< Length of each cond clause
+    std::unique_ptr<Scope> scope;                   ///< Scope of names
+    size_t body;                                    ///< Index of the first body form in subforms
+    bool body_begin;                                ///< Whether the body needs a Begin of its own
+    vector<Sym> locals;                             ///< Internal definitions of the body
+    std::unique_ptr<Scope> body_scope;              ///< Scope of locals
+
+    PendingForm(List *form, Scope *env) : form(form), env(env), kind(FORM_APPLY), op(nullptr), body(0), body_begin(false) {}
+};
+
+/**
+ * @brief Queue stxs[from..] as a body parsed in env
+ *
+ * Internal definitions get a scope of their own that encloses the whole
+ * body, mirroring the frame Begin::eval creates, so every variable in the
+ * body can be given its lexical address.
+ */
+static void planBody(PendingForm &f, size_t from, Scope &env) {
+    const SyntaxList &stxs = f.form->stxs;
+    for (size_t i = from; i < stxs.size(); i++) {
+        Sym name = definedName(stxs[i], env);
+        if (name != nullptr) {
+            f.locals.push_back(name);
+        }
+    }
+    f.body = f.subforms.size();
+    f.body_begin = !(f.locals.empty() && stxs.size() == from + 1);
+    Scope *body_env = &env;
+    if (!f.locals.empty()) {
+        f.body_scope.reset(new Scope(f.locals, &env));
+        body_env = f.body_scope.get();
+    }
+    for (size_t i = from; i < stxs.size(); i++) {
+        f.subforms.push_back({&stxs[i], body_env});
+    }
+}
+
+static Expr buildBody(PendingForm &f) {
+    if (!f.body_begin) return f.parsed[f.body];
+    return Expr(new Begin(vector<Expr>(f.parsed.begin() + f.body, f.parsed.end()), f.locals));
+}
+
+// 打开 names 的作用域，没有绑定时不产生帧
+static Scope &openScope(PendingForm &f) {
+    if (f.names.empty()) return *f.env;
+    f.scope.reset(new Scope(f.names, f.env));
+    return *f.scope;
+}
+
+// 依次解析 stxs[from..]
+static void planRest(PendingForm &f, size_t from, Scope &env) {
+    for (size_t i = from; i < f.form->stxs.size(); i++) {
+        f.subforms.push_back({&f.form->stxs[i], &env});
+    }
+}
+
+/**
+ * @brief Check the shape of f.form and queue its subforms
+ *
+ * Returns the node right away for a form without subforms to parse, and a
+ * null Expr otherwise.
+ */
+static Expr planForm(PendingForm &f) {
+    const SyntaxList &stxs = f.form->stxs;
+    Scope &env = *f.env;
+    f.subforms.reserve(stxs.size());
+    if (stxs.empty()) {
+        // 空列表 () 应该解析为一个引用的空列表，求值为 null
+        return Expr(new Quote(NullV()));
+    }
+
+    SymbolSyntax *id = stxs[0].as<SymbolSyntax>();
+    // 头部不是符号、是局部变量或普通的全局变量时是过程调用
+    if (id == nullptr || isLocal(id->s, env) || (id->s->primitive < 0 && id->s->reserved < 0)) {
+        f.kind = FORM_APPLY;
+        planRest(f, 0, env);
+        return Expr(nullptr);
+    }
+    f.op = id->s;
+    if (id->s->primitive >= 0) {
+        f.kind = FORM_PRIMITIVE;
+        planRest(f, 1, env);
+        return Expr(nullptr);
+    }
+    switch (id->s->reserved) {
+        case E_QUOTE:
+            if (stxs.size() != 2) throw RuntimeError("wrong parameter number for quote");
+            return Expr(new Quote(quoteDatum(stxs[1])));
+        case E_IF:
+            if (stxs.size() != 4) throw RuntimeError("wrong parameter number for if");
+            f.kind = FORM_IF;
+            planRest(f, 1, env);
+            break;
+        case E_AND:
+            f.kind = FORM_AND;
+            planRest(f, 1, env);
+            break;
+        case E_OR:
+            f.kind = FORM_OR;
+            planRest(f, 1, env);
+            break;
+        case E_BEGIN:
+            if (stxs.size() == 1) return Expr(new Begin(vector<Expr>()));
+            f.kind = FORM_BEGIN;
+            planBody(f, 1, env);
+            break;
+        case E_COND:
+            if (stxs.size() < 2) throw RuntimeError("wrong parameter number for cond");
+            f.kind = FORM_COND;
+            for (size_t i = 1; i < stxs.size(); i++) {
+                List *clause = stxs[i].as<List>();
+                if (clause == nullptr || clause->stxs.empty()) {
+                    throw RuntimeError("Invalid cond clause");
+                }
+                f.counts.push_back(clause->stxs.size());
+                for (const auto &stx : clause->stxs) {
+                    f.subforms.push_back({&stx, &env});
+                }
             }
-        } else if (op_type == E_GE) {
-            // >= 比较操作符
-            if (parameters.size() < 2) {
-                throw RuntimeError("Wrong number of arguments for >=");
-            } else if (parameters.size() == 2) {
-                return Expr(new GreaterEq(parameters[0], parameters[1])); // 保持二元兼容
-            } else {
-                return Expr(new GreaterEqVar(parameters)); // 多参数
+            break;
+        case E_LET:
+        case E_LETREC: {
+            bool let = id->s->reserved == E_LET;
+            if (stxs.size() != 3) throw RuntimeError(let ? "wrong parameter number for let" : "wrong parameter number for letrec");
+            List *bindings = stxs[1].as<List>();
+            if (bindings == nullptr) throw RuntimeError(let ? "Invalid let binding list" : "Invalid letrec binding list");
+            for (const auto &binding_stx : bindings->stxs) {
+                List *binding = binding_stx.as<List>();
+                if (binding == nullptr || binding->stxs.size() != 2) {
+                    throw RuntimeError(let ? "Invalid let binding list" : "Invalid letrec binding");
+                }
+                SymbolSyntax *name = binding->stxs[0].as<SymbolSyntax>();
+                if (name == nullptr) throw RuntimeError(let ? "Invalid input of identifier" : "Invalid letrec binding variable");
+                f.names.push_back(name->s);
             }
-        } else if (op_type == E_GT) {
-            // > 比较操作符
-            if (parameters.size() < 2) {
-                throw RuntimeError("Wrong number of arguments for >");
-            } else if (parameters.size() == 2) {
-                return Expr(new Greater(parameters[0], parameters[1])); // 保持二元兼容
-            } else {
-                return Expr(new GreaterVar(parameters)); // 多参数
+            // let 的绑定在外层作用域中解析，letrec 的绑定在新作用域中解析
+            f.kind = let ? FORM_LET : FORM_LETREC;
+            Scope &inner = openScope(f);
+            for (const auto &binding_stx : bindings->stxs) {
+                f.subforms.push_back({&binding_stx.as<List>()->stxs[1], let ? &env : &inner});
             }
-        } else {
-            // 其他原语保持原来的处理方式
-            return new Apply(stxs[0].get()->parse(env), parameters);
+            planBody(f, 2, inner);
+            break;
         }
+        case E_LAMBDA: {
+            if (stxs.size() < 3) throw RuntimeError("wrong parameter number for lambda");
+            List *params = stxs[1].as<List>();
+            if (params == nullptr) throw RuntimeError("Invalid lambda parameter list");
+            for (const auto &param_stx : params->stxs) {
+                SymbolSyntax *param = param_stx.as<SymbolSyntax>();
+                if (param == nullptr) throw RuntimeError("Invalid input of variable");
+                f.names.push_back(param->s);
+            }
+            // 多个body表达式会被包装在Begin中
+            f.kind = FORM_LAMBDA;
+            planBody(f, 2, openScope(f));
+            break;
+        }
+        case E_DEFINE: {
+            if (stxs.size() < 3) throw RuntimeError("wrong parameter number for define");
+            List *header = stxs[1].as<List>();
+            if (header == nullptr) {
+                // (define var-name expression)
+                if (stxs.size() != 3) throw RuntimeError("wrong parameter number for simple define");
+                SymbolSyntax *var = stxs[1].as<SymbolSyntax>();
+                if (var == nullptr) throw RuntimeError("Invalid define variable");
+                f.kind = FORM_DEFINE;
+                f.op = var->s;
+                planRest(f, 2, env);
+                break;
+            }
+            // 语法糖: (define (func-name param1 param2 ...) body...)
+            if (header->stxs.empty()) {
+                throw RuntimeError("Invalid function definition: empty parameter list");
+            }
+            SymbolSyntax *name = header->stxs[0].as<SymbolSyntax>();
+            if (name == nullptr) throw RuntimeError("Invalid function name in define");
+            for (size_t i = 1; i < header->stxs.size(); i++) {
+                SymbolSyntax *param = header->stxs[i].as<SymbolSyntax>();
+                if (param == nullptr) throw RuntimeError("Invalid parameter in function definition");
+                f.names.push_back(param->s);
+            }
+            f.kind = FORM_DEFINE_LAMBDA;
+            f.op = name->s;
+            planBody(f, 2, openScope(f));
+            break;
+        }
+        case E_SET: {
+            if (stxs.size() != 3) throw RuntimeError("wrong parameter number for set!");
+            SymbolSyntax *var = stxs[1].as<SymbolSyntax>();
+            if (var == nullptr) throw RuntimeError("Invalid set! variable");
+            f.kind = FORM_SET;
+            f.op = var->s;
+            planRest(f, 2, env);
+            break;
+        }
+        default:
+            throw RuntimeError("Unknown reserved word: " + id->s->name);
     }
-    // 检查是否为保留字
-    if (reserved_words.count(op) != 0) {
-    	switch (reserved_words[op]) {
-        	case E_LET:{
-            		if (stxs.size() != 3) throw RuntimeError("wrong parameter number for let");
-        		vector<pair<string, Expr>> binded_vector;
-            		List *binder_list_ptr = dynamic_cast<List*>(stxs[1].get());
-            		if (binder_list_ptr == nullptr) {throw RuntimeError("Invalid let binding list");}
-
-            		Assoc local_env = env; // 创建新的环境
-                	for (int i = 0; i < binder_list_ptr->stxs.size(); i++) {
-                     		auto pair_it = dynamic_cast<List*>(binder_list_ptr->stxs[i].get());
-                     		if ((pair_it == nullptr)||(pair_it->stxs.size() != 2)) {throw RuntimeError("Invalid let binding list");}
-                     		auto Identifiers = dynamic_cast<SymbolSyntax*>(pair_it->stxs.front().get());
-                     		if (Identifiers == nullptr) {throw RuntimeError("Invalid input of identifier");}
-                      		Expr temp_expr = pair_it->stxs.back().get()->parse(env);
-                      		local_env = extend(Identifiers->s, NullV(), local_env);
-                      		pair<string, Expr> tmp_pair = std::make_pair(Identifiers->s, temp_expr);
-                      		binded_vector.push_back(tmp_pair);
-                	}
-             		return Expr(new Let(binded_vector, stxs[2]->parse(local_env))); // 使用 local_env
-        	}
-        	case E_IF:{if (stxs.size() != 4) throw RuntimeError("wrong parameter number for if");return Expr(new If(stxs[1]->parse(env), stxs[2]->parse(env), stxs[3]->parse(env)));}
-        	case E_BEGIN:{
-             		vector<Expr> passed_exprs;
-    		      	for (size_t i = 1; i < stxs.size(); i++) {
-        		        passed_exprs.push_back(stxs[i]->parse(env));
-    			}
-             		return Expr(new Begin(passed_exprs));
-        	}
-        	case E_AND:{
-             		vector<Expr> passed_exprs;
-    		      	for (size_t i = 1; i < stxs.size(); i++) {
-        		        passed_exprs.push_back(stxs[i]->parse(env));
-    			}
-             		return Expr(new And(passed_exprs));
-        	}
-        	case E_OR:{
-             		vector<Expr> passed_exprs;
-    		      	for (size_t i = 1; i < stxs.size(); i++) {
-        		        passed_exprs.push_back(stxs[i]->parse(env));
-    			}
-             		return Expr(new Or(passed_exprs));
-        	}
-        	case E_COND:{
-             		if (stxs.size() < 2) throw RuntimeError("wrong parameter number for cond");
-             		vector<vector<Expr>> clauses;
-             		for (size_t i = 1; i < stxs.size(); i++) {
-                 		List* clause_list = dynamic_cast<List*>(stxs[i].get());
-                 		if (clause_list == nullptr || clause_list->stxs.empty()) {
-                     			throw RuntimeError("Invalid cond clause");
-                 		}
-                 		vector<Expr> clause_exprs;
-                 		for (auto& clause_stx : clause_list->stxs) {
-                     			clause_exprs.push_back(clause_stx->parse(env));
-                 		}
-                 		clauses.push_back(clause_exprs);
-             		}
-             		return Expr(new Cond(clauses));
-        	}
-        	case E_QUOTE:{if (stxs.size() != 2) throw RuntimeError("wrong parameter number for quote");return Expr(new Quote(stxs[1]));}
-        	case E_LAMBDA:{
-            		if (stxs.size() < 3) throw RuntimeError("wrong parameter number for lambda");
-            		Assoc New_env = env;
-                	std::vector<std::string> vars;
-                	List* paras_ptr = dynamic_cast<List*>(stxs[1].get());
-                	if (paras_ptr == nullptr) {throw RuntimeError("Invalid lambda parameter list");}
-            		for (int i = 0; i < paras_ptr->stxs.size(); i++) {
-                     		if (auto tmp_var = dynamic_cast<Var*>(paras_ptr->stxs[i].get()->parse(env).get())) {
-                         		vars.push_back(tmp_var->x);
-                         		New_env = extend(tmp_var->x, NullV(), New_env);
-                     		} else {
-                         		throw RuntimeError("Invalid input of variable");
-                     		}	
-                	}
-                	
-                	// 处理多个body表达式
-                	if (stxs.size() == 3) {
-                		// 单个body表达式
-                		return Expr(new Lambda(vars, stxs[2].get()->parse(New_env)));
-                	} else {
-                		// 多个body表达式，包装在Begin中
-                		vector<Expr> body_exprs;
-                		for (size_t i = 2; i < stxs.size(); i++) {
-                			body_exprs.push_back(stxs[i]->parse(New_env));
-                		}
-                		return Expr(new Lambda(vars, Expr(new Begin(body_exprs))));
-                	}
-        	}
-        	case E_LETREC:{
-    			if (stxs.size() != 3) throw RuntimeError("wrong parameter number for letrec");
-    			vector<pair<string, Expr>> binded_vector;
-    			List *binder_list_ptr = dynamic_cast<List*>(stxs[1].get());
-    			if (binder_list_ptr == nullptr) {throw RuntimeError("Invalid letrec binding list");}
-
-    			// 创建新的环境用于解析
-    			Assoc temp_env = env;
-
-    			// 第一次遍历：收集所有变量名并在临时环境中绑定为 null
-    			for (auto &stx_tobind_raw : binder_list_ptr->stxs) {
-        			List *stx_tobind = dynamic_cast<List*>(stx_tobind_raw.get());
-        			if (stx_tobind == nullptr || stx_tobind->stxs.size() != 2) {throw RuntimeError("Invalid letrec binding");}
-
-        			SymbolSyntax *temp_id = dynamic_cast<SymbolSyntax*>(stx_tobind->stxs[0].get());
-        			if (temp_id == nullptr) {throw RuntimeError("Invalid letrec binding variable");}
-				
-        			// 在临时环境中绑定变量，初始值为 null
-        			temp_env = extend(temp_id->s, NullV(), temp_env);
-    			}
-
-    			// 第二次遍历：使用包含所有变量的环境解析表达式
-    			for (auto &stx_tobind_raw : binder_list_ptr->stxs) {
-        			List *stx_tobind = dynamic_cast<List*>(stx_tobind_raw.get());
-        			SymbolSyntax *temp_id = dynamic_cast<SymbolSyntax*>(stx_tobind->stxs[0].get());
-
-        			// 在包含所有变量的环境中解析表达式
-        			Expr temp_store = stx_tobind->stxs[1]->parse(temp_env);
-        			binded_vector.push_back(std::make_pair(temp_id->s, temp_store));
-    			}
-
-    			// 使用同样的环境解析 body
-    			return Expr(new Letrec(binded_vector, stxs[2]->parse(temp_env)));
-		}
-		case E_DEFINE:{
-			if (stxs.size() < 3) throw RuntimeError("wrong parameter number for define");
-			
-			// 检查第二个元素是否为List（函数定义语法糖）
-			List *func_def_list = dynamic_cast<List*>(stxs[1].get());
-			if (func_def_list != nullptr) {
-				// 语法糖: (define (func-name param1 param2 ...) body...)
-				if (func_def_list->stxs.empty()) {
-					throw RuntimeError("Invalid function definition: empty parameter list");
-				}
-				
-				// 第一个元素应该是函数名
-				SymbolSyntax *func_name = dynamic_cast<SymbolSyntax*>(func_def_list->stxs[0].get());
-				if (func_name == nullptr) {
-					throw RuntimeError("Invalid function name in define");
-				}
-				
-				// 提取参数列表
-				vector<string> param_names;
-				for (size_t i = 1; i < func_def_list->stxs.size(); i++) {
-					SymbolSyntax *param = dynamic_cast<SymbolSyntax*>(func_def_list->stxs[i].get());
-					if (param == nullptr) {
-						throw RuntimeError("Invalid parameter in function definition");
-					}
-					param_names.push_back(param->s);
-				}
-				
-				// 创建lambda表达式，支持多个body表达式
-				if (stxs.size() == 3) {
-					// 单个body表达式
-					Expr lambda_expr = Expr(new Lambda(param_names, stxs[2]->parse(env)));
-					return Expr(new Define(func_name->s, lambda_expr));
-				} else {
-					// 多个body表达式，包装在Begin中
-					vector<Expr> body_exprs;
-					for (size_t i = 2; i < stxs.size(); i++) {
-						body_exprs.push_back(stxs[i]->parse(env));
-					}
-					Expr lambda_expr = Expr(new Lambda(param_names, Expr(new Begin(body_exprs))));
-					return Expr(new Define(func_name->s, lambda_expr));
-				}
-			} else {
-				// 原有语法: (define var-name expression)
-				if (stxs.size() != 3) throw RuntimeError("wrong parameter number for simple define");
-				SymbolSyntax *var_id = dynamic_cast<SymbolSyntax*>(stxs[1].get());
-				if (var_id == nullptr) {throw RuntimeError("Invalid define variable");}
-				return Expr(new Define(var_id->s, stxs[2]->parse(env)));
-			}
-		}
-		case E_SET:{
-			if (stxs.size() != 3) throw RuntimeError("wrong parameter number for set!");
-			SymbolSyntax *var_id = dynamic_cast<SymbolSyntax*>(stxs[1].get());
-			if (var_id == nullptr) {throw RuntimeError("Invalid set! variable");}
-			return Expr(new Set(var_id->s, stxs[2]->parse(env)));
-		}
-        	default:
-            	throw RuntimeError("Unknown reserved word: " + op);
-    	}
-    }
+    return Expr(nullptr);
+}
 
-    // 默认情况：构造 Apply 表达式
-    Expr opexpr = stxs[0]->parse(env);
-    vector<Expr> to_expr;
-    for (size_t i = 1; i < stxs.size(); i++) {
-        to_expr.push_back(stxs[i]->parse(env));
+/**
+ * @brief Assemble the node of f once all its subforms are parsed
+ */
+static Expr buildForm(PendingForm &f) {
+    vector<Expr> &parsed = f.parsed;
+    switch (f.kind) {
+        case FORM_APPLY:
+            return Expr(new Apply(parsed[0], vector<Expr>(parsed.begin() + 1, parsed.end())));
+        case FORM_PRIMITIVE:
+            return foldConstants(makePrimitiveCall(f.op, parsed, f.form->stxs[0], *f.env));
+        case FORM_IF:
+            return Expr(new If(parsed[0], parsed[1], parsed[2]));
+        case FORM_AND:
+            return Expr(new And(parsed));
+        case FORM_OR:
+            return Expr(new Or(parsed));
+        case FORM_BEGIN: {
+            Expr body = buildBody(f);
+            if (body->e_type == E_BEGIN) return body;
+            return Expr(new Begin(vector<Expr>(1, body)));
+        }
+        case FORM_COND: {
+            vector<vector<Expr>> clauses;
+            clauses.reserve(f.counts.size());
+            size_t next = 0;
+            for (size_t count : f.counts) {
+                clauses.push_back(vector<Expr>(parsed.begin() + next, parsed.begin() + next + count));
+                next += count;
+            }
+            return Expr(new Cond(clauses));
+        }
+        case FORM_LET:
+        case FORM_LETREC: {
+            vector<pair<Sym, Expr>> bindings;
+            bindings.reserve(f.names.size());
+            for (size_t i = 0; i < f.names.size(); i++) {
+                bindings.push_back(std::make_pair(f.names[i], parsed[i]));
+            }
+            if (f.kind == FORM_LET) return Expr(new Let(bindings, buildBody(f)));
+            return Expr(new Letrec(bindings, buildBody(f)));
+        }
+        case FORM_LAMBDA:
+        case FORM_DEFINE_LAMBDA: {
+            Expr body = buildBody(f);
+            markTailCalls(body);
+            Expr lambda(new Lambda(f.names, body));
+            if (f.kind == FORM_LAMBDA) return lambda;
+            return makeDefine(f.op, lambda, *f.env);
+        }
+        case FORM_DEFINE:
+            return makeDefine(f.op, parsed[0], *f.env);
+        case FORM_SET: {
+            int depth = -1, index = 0;
+            f.env->lookup(f.op, depth, index);
+            return Expr(new Set(f.op, parsed[0], depth, index));
+        }
     }
-    return Expr(new Apply(opexpr, to_expr));
+    throw RuntimeError("Unknown form");
+}
+
+/**
+ * @brief Parse a list form and everything nested in it
+ *
+ * Nested lists are not parsed through recursive calls: they wait on an
+ * explicit stack of pending forms, see PendingForm.
+ */
+Expr List::parse(Scope &env) {
+    vector<PendingForm> pending;
+    List *form = this;
+    const Syntax *next = nullptr;
+    Scope *next_env = &env;
+    while (true) {
+        Expr e(nullptr);
+        if (form != nullptr) {
+            pending.push_back(PendingForm(form, next_env));
+            e = planForm(pending.back());
+            if (e.get() != nullptr) {
+                pending.pop_back();
+            } else if (pending.back().subforms.empty()) {
+                e = buildForm(pending.back());
+                pending.pop_back();
+            } else {
+                pending.back().parsed.reserve(pending.back().subforms.size());
+            }
+        } else {
+            e = (*next)->parse(*next_env);
+        }
+        // 把解析好的节点交给等它的形式，子形式都齐了的形式随即组装，再交给外层
+        while (e.get() != nullptr) {
+            if (pending.empty()) return e;
+            PendingForm &top = pending.back();
+            top.parsed.push_back(e);
+            if (top.parsed.size() < top.subforms.size()) break;
+            e = buildForm(top);
+            pending.pop_back();
+        }
+        PendingForm &top = pending.back();
+        next = top.subforms[top.parsed.size()].first;
+        next_env = top.subforms[top.parsed.size()].second;
+        form = next->as<List>();
     }
 }
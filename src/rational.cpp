@@ -0,0 +1,203 @@
+/**
+ * @file rational.cpp
+ * @brief Exact rational arithmetic kernel
+ *
+ * The reductions follow Knuth, TAOCP vol. 2, 4.5.1: with a/b and c/d in
+ * lowest terms, a/b * c/d = (a/g1 * c/g2) / (b/g2 * d/g1) where
+ * g1 = gcd(a, d) and g2 = gcd(c, b) is already reduced, and for a sum only
+ * the gcd of the new numerator with g = gcd(b, d) remains to be divided out.
+ */
+
+#include "rational.hpp"
+#include <cmath>
+
+typedef __int128 int128;
+typedef unsigned __int128 uint128;
+
+namespace {
+
+bool isSmall(const Ratio &q) {
+    return q.num.fitsLong() && q.den.fitsLong();
+}
+
+uint64_t absSmall(long long v) {
+    return v < 0 ? 0 - uint64_t(v) : uint64_t(v);
+}
+
+BigInt fromInt128(int128 v) {
+    BigInt r;
+    uint128 m = v < 0 ? 0 - uint128(v) : uint128(v);
+    while (m) {
+        r.mag.push_back(uint32_t(m));
+        m >>= 32;
+    }
+    r.neg = v < 0;
+    return r;
+}
+
+// 分子分母已经约分且分母为正
+Ratio fromParts(int128 num, int128 den) {
+    Ratio r;
+    r.num = fromInt128(num);
+    r.den = fromInt128(den);
+    return r;
+}
+
+Ratio fromParts(const BigInt &num, const BigInt &den) {
+    Ratio r;
+    r.num = num;
+    r.den = den;
+    return r;
+}
+
+// 已知能整除时的除法
+BigInt exactDiv(const BigInt &a, const BigInt &b) {
+    BigInt q, r;
+    divmod(a, b, q, r);
+    return q;
+}
+
+bool isOne(const BigInt &n) {
+    return !n.neg && n.mag.size() == 1 && n.mag[0] == 1;
+}
+
+} // namespace
+
+uint64_t binaryGcd(uint64_t u, uint64_t v) {
+    if (u == 0) return v;
+    if (v == 0) return u;
+    int shift = __builtin_ctzll(u | v);
+    u >>= __builtin_ctzll(u);
+    do {
+        v >>= __builtin_ctzll(v);
+        if (u > v) {
+            uint64_t t = u;
+            u = v;
+            v = t;
+        }
+        v -= u;
+    } while (v != 0);
+    return u << shift;
+}
+
+Ratio::Ratio() : den(1) {}
+
+Ratio::Ratio(const BigInt &n) : num(n), den(1) {}
+
+bool Ratio::isInteger() const {
+    return isOne(den);
+}
+
+double Ratio::toDouble() const {
+    int nbits = num.bitLength(), dbits = den.bitLength();
+    if (nbits <= 53 && dbits <= 53) {
+        // 两者都能精确转换时，一次浮点除法就是正确舍入的
+        return num.toDouble() / den.toDouble();
+    }
+    // 放大到商有 64 位以上，余数不为 0 时置粘滞位，再按 2 的幂缩回
+    int k = 65 - (nbits - dbits);
+    BigInt q, r;
+    divmod(k > 0 ? num << k : num, k < 0 ? den << -k : den, q, r);
+    if (!r.isZero()) q.mag[0] |= 1;
+    return std::ldexp(q.toDouble(), -k);
+}
+
+Ratio exactRatio(double d) {
+    // d = m * 2^e，其中 m 是 53 位整数
+    int e;
+    double frac = std::frexp(d, &e);
+    BigInt m((long long)std::ldexp(frac, 53));
+    e -= 53;
+    if (e >= 0) return Ratio(m << e);
+    return makeRatio(m, BigInt(1) << -e);
+}
+
+Ratio makeRatio(const BigInt &num, const BigInt &den) {
+    if (num.fitsLong() && den.fitsLong()) {
+        int128 n = num.toLong(), d = den.toLong();
+        uint64_t g = binaryGcd(absSmall(num.toLong()), absSmall(den.toLong()));
+        n /= int128(g);
+        d /= int128(g);
+        if (d < 0) {
+            n = -n;
+            d = -d;
+        }
+        return fromParts(n, d);
+    }
+    BigInt g = gcd(num, den);
+    BigInt n = exactDiv(num, g), d = exactDiv(den, g);
+    if (d.sign() < 0) {
+        n = -n;
+        d = -d;
+    }
+    return fromParts(n, d);
+}
+
+Ratio operator+(const Ratio &x, const Ratio &y) {
+    if (isSmall(x) && isSmall(y)) {
+        long long a = x.num.toLong(), b = x.den.toLong();
+        long long c = y.num.toLong(), d = y.den.toLong();
+        long long g = (long long)binaryGcd(uint64_t(b), uint64_t(d));
+        // |a * (d/g)| 和 |c * (b/g)| 都小于 2^126，和不会溢出
+        int128 t = int128(a) * (d / g) + int128(c) * (b / g);
+        if (g == 1) {
+            return fromParts(t, int128(b) * d);
+        }
+        int128 rem = t % g;
+        long long g2 = (long long)binaryGcd(uint64_t(rem < 0 ? -rem : rem), uint64_t(g));
+        return fromParts(t / g2, int128(b / g) * (d / g2));
+    }
+    if (x.isInteger() && y.isInteger()) {
+        return Ratio(x.num + y.num);
+    }
+    BigInt g = gcd(x.den, y.den);
+    if (isOne(g)) {
+        return fromParts(x.num * y.den + y.num * x.den, x.den * y.den);
+    }
+    BigInt t = x.num * exactDiv(y.den, g) + y.num * exactDiv(x.den, g);
+    BigInt g2 = gcd(t, g);
+    return fromParts(exactDiv(t, g2), exactDiv(x.den, g) * exactDiv(y.den, g2));
+}
+
+Ratio operator-(const Ratio &x) {
+    return fromParts(-x.num, x.den);
+}
+
+Ratio operator-(const Ratio &x, const Ratio &y) {
+    return x + (-y);
+}
+
+Ratio operator*(const Ratio &x, const Ratio &y) {
+    if (x.num.isZero() || y.num.isZero()) {
+        return Ratio();
+    }
+    if (isSmall(x) && isSmall(y)) {
+        long long a = x.num.toLong(), b = x.den.toLong();
+        long long c = y.num.toLong(), d = y.den.toLong();
+        long long g1 = (long long)binaryGcd(absSmall(a), uint64_t(d));
+        long long g2 = (long long)binaryGcd(absSmall(c), uint64_t(b));
+        return fromParts(int128(a / g1) * (c / g2), int128(b / g2) * (d / g1));
+    }
+    BigInt g1 = gcd(x.num, y.den), g2 = gcd(y.num, x.den);
+    return fromParts(exactDiv(x.num, g1) * exactDiv(y.num, g2),
+                     exactDiv(x.den, g2) * exactDiv(y.den, g1));
+}
+
+Ratio operator/(const Ratio &x, const Ratio &y) {
+    // 乘以倒数，倒数的符号移到分子上
+    BigInt num = y.num.sign() < 0 ? -y.den : y.den;
+    BigInt den = y.num.sign() < 0 ? -y.num : y.num;
+    return x * fromParts(num, den);
+}
+
+int compare(const Ratio &x, const Ratio &y) {
+    if (isSmall(x) && isSmall(y)) {
+        int128 l = int128(x.num.toLong()) * y.den.toLong();
+        int128 r = int128(y.num.toLong()) * x.den.toLong();
+        return l < r ? -1 : l > r ? 1 : 0;
+    }
+    if (x.num.sign() != y.num.sign()) {
+        return x.num.sign() < y.num.sign() ? -1 : 1;
+    }
+    return compare(x.num * y.den, y.num * x.den);
+}
@@ -0,0 +1,49 @@
+#ifndef RATIONAL_HPP
+#define RATIONAL_HPP
+
+/**
+ * @file rational.hpp
+ * @brief Exact rational arithmetic kernel
+ *
+ * A Ratio is always in lowest terms with a positive denominator. The
+ * operations keep it that way without a full gcd of the final numerator
+ * and denominator: sums reduce by the gcd of the denominators first and
+ * products cancel crosswise before multiplying, so intermediates stay as
+ * small as the result allows.
+ *
+ * Operands whose parts fit in 64 bits are combined with 128-bit
+ * intermediates and a binary gcd; anything larger goes through BigInt.
+ */
+
+#include "bigint.hpp"
+#include <cstdint>
+
+struct Ratio {
+    BigInt num;         ///< Numerator, carries the sign
+    BigInt den;         ///< Denominator, always positive
+    Ratio();            ///< Zero
+    Ratio(const BigInt &);
+    bool isInteger() const;
+    double toDouble() const;    ///< Correctly rounded quotient
+};
+
+/**
+ * @brief Exact value of a finite double
+ */
+Ratio exactRatio(double);
+
+/**
+ * @brief Reduce num/den to lowest terms; den must not be zero
+ */
+Ratio makeRatio(const BigInt &, const BigInt &);
+
+Ratio operator+(const Ratio &, const Ratio &);
+Ratio operator-(const Ratio &, const Ratio &);
+Ratio operator*(const Ratio &, const Ratio &);
+Ratio operator/(const Ratio &, const Ratio &);   ///< The divisor must not be zero
+Ratio operator-(const Ratio &);
+int compare(const Ratio &, const Ratio &);
+
+uint64_t binaryGcd(uint64_t, uint64_t);
+
+#endif // RATIONAL_HPP
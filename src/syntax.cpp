@@ -1,36 +1,107 @@
 #include "syntax.hpp"
+#include "RE.hpp"
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cmath>
+#include <cstdlib>
 #include <cstring>
 #include <vector>
 
 Syntax::Syntax(SyntaxBase *stx) : ptr(stx) {}
-SyntaxBase* Syntax::operator->() const { return ptr.get(); }
+SyntaxBase* Syntax::operator->() const { return ptr; }
 SyntaxBase& Syntax::operator*() { return *ptr; }
-SyntaxBase* Syntax::get() const { return ptr.get(); }
+SyntaxBase* Syntax::get() const { return ptr; }
 
-Number::Number(int n) : n(n) {}
+namespace {
+
+const size_t ARENA_BLOCK_SIZE = 1 << 16;
+const size_t ARENA_ALIGN = alignof(std::max_align_t);
+
+} // namespace
+
+SyntaxArena syntax_arena;
+
+SyntaxArena::SyntaxArena() : current(0), cur(nullptr), end(nullptr) {}
+
+SyntaxArena::~SyntaxArena() {
+    reset();
+    for (const auto &block : blocks) free(block.data);
+}
+
+void *SyntaxArena::allocate(size_t size) {
+    size = (size + ARENA_ALIGN - 1) & ~(ARENA_ALIGN - 1);
+    if (size > size_t(end - cur)) grow(size);
+    void *p = cur;
+    cur += size;
+    return p;
+}
+
+void SyntaxArena::grow(size_t size) {
+    // 先用 reset 后留下的块；比一块还大的请求单独占一块
+    if (cur != nullptr) current++;
+    if (current == blocks.size() || blocks[current].size < size) {
+        size_t block_size = std::max(size, ARENA_BLOCK_SIZE);
+        char *data = static_cast<char *>(malloc(block_size));
+        if (data == nullptr) throw std::bad_alloc();
+        blocks.insert(blocks.begin() + current, {data, block_size});
+    }
+    cur = blocks[current].data;
+    end = cur + blocks[current].size;
+}
+
+Syntax *SyntaxArena::array(size_t n) {
+    return static_cast<Syntax *>(allocate(n * sizeof(Syntax)));
+}
+
+void SyntaxArena::reset() {
+    for (const auto &f : finalizers) f.second(f.first);
+    finalizers.clear();
+    // 只保留第一块，一个特别大的数据读完后不再长期占用内存
+    for (size_t i = 1; i < blocks.size(); i++) free(blocks[i].data);
+    if (blocks.size() > 1) blocks.resize(1);
+    current = 0;
+    cur = blocks.empty() ? nullptr : blocks[0].data;
+    end = blocks.empty() ? nullptr : cur + blocks[0].size;
+}
+
+Number::Number(int n) : SyntaxBase(S_NUMBER), n(n) {}
 void Number::show(std::ostream &os) {
   os << "the-number-" << n;
 }
 
+BigNumber::BigNumber(const BigInt &n) : SyntaxBase(S_BIGNUM), n(n) {}
+void BigNumber::show(std::ostream &os) {
+  os << "the-number-" << n.toString();
+}
+
+FlonumSyntax::FlonumSyntax(double d) : SyntaxBase(S_FLONUM), d(d) {}
+void FlonumSyntax::show(std::ostream &os) {
+  os << "the-number-" << d;
+}
+
+TrueSyntax::TrueSyntax() : SyntaxBase(S_TRUE) {}
 void TrueSyntax::show(std::ostream &os) {
   os << "#t";
 }
 
+FalseSyntax::FalseSyntax() : SyntaxBase(S_FALSE) {}
 void FalseSyntax::show(std::ostream &os) {
   os << "#f";
 }
 
-SymbolSyntax::SymbolSyntax(const std::string &s1) : s(s1) {}
+SymbolSyntax::SymbolSyntax(Sym s1) : SyntaxBase(S_SYMBOL), s(s1) {}
 void SymbolSyntax::show(std::ostream &os) {
-    os << s;
+    os << s->name;
 }
 
-StringSyntax::StringSyntax(const std::string &s1) : s(s1) {}
+StringSyntax::StringSyntax(const std::string &s1) : SyntaxBase(S_STRING), s(s1) {}
 void StringSyntax::show(std::ostream &os) {
     os << "\"" << s << "\"";
 }
 
-List::List() {}
+List::List(Syntax *items, size_t count) : SyntaxBase(S_LIST), stxs{items, count} {}
+
 void List::show(std::ostream &os) {
     os << '(';
     for (auto stx : stxs) {
@@ -40,36 +111,15 @@ void List::show(std::ostream &os) {
     os << ')';
 }
 
-std::istream &readSpace(std::istream &is) {
-  while (true) {
-    // 跳过空白字符
-    while (isspace(is.peek()))
-      is.get();
-    
-    // 检查是否是注释
-    if (is.peek() == ';') {
-      // 跳过注释直到行末
-      while (is.peek() != '\n' && is.peek() != EOF)
-        is.get();
-      // 继续循环以跳过注释后的空白字符
-    } else {
-      // 没有更多空白字符或注释，退出循环
-      break;
-    }
-  }
-  return is;
-}
-
-Syntax readList(std::istream &is);
 
 // Helper function to try parsing as integer
-bool tryParseNumber(const std::string &s, int &result) {
+bool tryParseNumber(const char *s, size_t len, int &result) {
   bool neg = false;
-  int n = 0;
-  int i = 0;
+  long long n = 0;
+  size_t i = 0;
   
   // Single '+' or '-' are not numbers
-  if (s.size() == 1 && (s[0] == '+' || s[0] == '-'))
+  if (len == 1 && (s[0] == '+' || s[0] == '-'))
     return false;
   
   // Handle sign
@@ -81,110 +131,230 @@ bool tryParseNumber(const std::string &s, int &result) {
   }
   
   // Check if all remaining characters are digits
-  for (; i < s.size(); i++) {
+  for (; i < len; i++) {
     if ('0' <= s[i] && s[i] <= '9') {
       n = n * 10 + s[i] - '0';
+      // 超出 fixnum 范围的整数交给 BigNumber
+      if (n > (long long)INT_MAX + neg)
+        return false;
     } else {
       return false;  // Not a valid number
     }
   }
   
-  result = neg ? -n : n;
+  result = int(neg ? -n : n);
+  return true;
+}
+
+// Helper function to try parsing as a decimal (inexact) number:
+// [+-] digits [. digits] [e [+-] digits], at least one digit before the
+// exponent, plus +inf.0, -inf.0 and +nan.0
+bool tryParseFlonum(const std::string &s, double &result) {
+  if (s == "+inf.0" || s == "-inf.0" || s == "+nan.0" || s == "-nan.0") {
+    result = s[1] == 'n' ? NAN : s[0] == '-' ? -INFINITY : INFINITY;
+    return true;
+  }
+  size_t i = 0, digits = 0;
+  if (i < s.size() && (s[i] == '+' || s[i] == '-'))
+    i++;
+  while (i < s.size() && isdigit((unsigned char)s[i])) {
+    i++;
+    digits++;
+  }
+  if (i < s.size() && s[i] == '.') {
+    i++;
+    while (i < s.size() && isdigit((unsigned char)s[i])) {
+      i++;
+      digits++;
+    }
+  }
+  if (digits == 0)
+    return false;
+  if (i < s.size() && (s[i] == 'e' || s[i] == 'E')) {
+    i++;
+    if (i < s.size() && (s[i] == '+' || s[i] == '-'))
+      i++;
+    size_t exponent_digits = 0;
+    while (i < s.size() && isdigit((unsigned char)s[i])) {
+      i++;
+      exponent_digits++;
+    }
+    if (exponent_digits == 0)
+      return false;
+  }
+  if (i != s.size())
+    return false;
+  result = strtod(s.c_str(), nullptr);
   return true;
 }
 
 // Helper function to create identifier/symbol syntax
 Syntax createIdentifierSyntax(const std::string &s) {
   if (s == "#t")
-    return Syntax(new TrueSyntax());
+    return Syntax(syntax_arena.make<TrueSyntax>());
   if (s == "#f")
-    return Syntax(new FalseSyntax());
-  return Syntax(new SymbolSyntax(s));
+    return Syntax(syntax_arena.make<FalseSyntax>());
+  return Syntax(syntax_arena.make<SymbolSyntax>(intern(s)));  // 读入时即完成驻留
 }
 
-// no leading space
-Syntax readItem(std::istream &is) {
-  if (is.peek() == '(' || is.peek() == '[') {
-    is.get();
-    return readList(is);
-  }
-  if (is.peek() == '\'')
-  {
-    is.get();
-    // 读取单引号后的语法元素
-    Syntax quoted_syntax = readItem(is);
-    
-    // 创建 (quote <syntax>) 的列表结构
-    List *quote_list = new List();
-    quote_list->stxs.push_back(Syntax(new SymbolSyntax("quote")));
-    quote_list->stxs.push_back(quoted_syntax);
-    
-    return Syntax(quote_list);
-  }
-  // 处理字符串字面量
-  if (is.peek() == '"') {
-    is.get(); // 消费开始的双引号
-    std::string str;
-    while (is.peek() != '"' && is.peek() != EOF) {
-      char c = is.get();
-      if (c == '\\') {
-        // 处理转义字符
-        char next = is.get();
-        switch (next) {
-          case 'n': str.push_back('\n'); break;
-          case 't': str.push_back('\t'); break;
-          case 'r': str.push_back('\r'); break;
-          case '\\': str.push_back('\\'); break;
-          case '"': str.push_back('"'); break;
-          default: str.push_back(next); break;
-        }
-      } else {
-        str.push_back(c);
-      }
-    }
-    if (is.peek() == '"') {
-      is.get(); // 消费结束的双引号
+size_t max_read_depth = 1000000;
+
+namespace {
+
+/**
+ * @brief A list the reader has opened and not closed yet
+ *
+ * Its elements so far are items[start..] of the reader's scratch vector.
+ * A quote is read as a list (quote) that closes by itself as soon as its
+ * one datum is complete.
+ */
+struct OpenList {
+  size_t start;
+  bool quote;
+};
+
+// 闭合最内层的表：元素从暂存区搬进 arena 中正好大小的数组
+Syntax closeList(std::vector<Syntax> &items, size_t start) {
+  size_t count = items.size() - start;
+  Syntax *elements = syntax_arena.array(count);
+  std::copy(items.begin() + start, items.end(), elements);
+  items.erase(items.begin() + start, items.end());
+  return Syntax(syntax_arena.make<List>(elements, count));
+}
+
+// 读入一个原子：数字、#t、#f 或标识符。c 是它的第一个字符
+Syntax readAtom(Lexer &lex, int c) {
+  const char *token;
+  size_t len;
+  lex.token(token, len);
+  if (len == 0) {
+    // 只有在输入结束或遇到多余的右括号时 token 才会为空
+    if (c == EOF) {
+      throw RuntimeError("Unexpected end of input");
     }
-    return Syntax(new StringSyntax(str));
+    lex.advance();
+    throw RuntimeError("Unexpected )");
   }
   
-  // Read token
-  std::string s;
-  do {
-    int c = is.peek();
-    if (c == '(' || c == ')' ||
-        c == '[' || c == ']' || 
-        c == ';' ||  // 添加分号作为分隔符
-        isspace(c) ||
-        c == EOF)
-      break;
-    is.get();
-    s.push_back(c);
-  } while (true);
-  
   // Try parsing as integer
   int number_value;
-  if (tryParseNumber(s, number_value)) {
-    return Syntax(new Number(number_value));
+  if (tryParseNumber(token, len, number_value)) {
+    return Syntax(syntax_arena.make<Number>(number_value));
+  }
+  std::string s(token, len);
+  BigInt big_value;
+  if (parseBigInt(s, big_value)) {
+    return Syntax(syntax_arena.make<BigNumber>(big_value));
+  }
+  double flonum_value;
+  if (tryParseFlonum(s, flonum_value)) {
+    return Syntax(syntax_arena.make<FlonumSyntax>(flonum_value));
   }
   
   // Not a number, treat as identifier/symbol
   return createIdentifierSyntax(s);
 }
 
-Syntax readList(std::istream &is) {
-    List *stx = new List();
-    while (readSpace(is).peek() != ')' && readSpace(is).peek() != ')')
-        stx->stxs.push_back(readItem(is));
-    is.get(); // ')'
-    return Syntax(stx);
+// 嵌套超过上限：跳过这个数据剩下的部分，不建语法树，只跟踪还没闭合的表
+// 和还欠一个数据的 quote，之后的输入从下一个数据开始读
+void skipNested(Lexer &lex, std::vector<OpenList> &open) {
+  std::string scratch;
+  while (!open.empty()) {
+    lex.skipSpace();
+    int c = lex.peek();
+    if (c == EOF) return;
+    lex.advance();
+    if (c == '(' || c == '[' || c == '\'') {
+      open.push_back({0, c == '\''});
+      continue;
+    }
+    if (c == ')' || c == ']') {
+      // 缺数据的 quote 随外层的表一起结束
+      while (!open.empty() && open.back().quote) open.pop_back();
+      if (!open.empty()) open.pop_back();
+    } else if (c == '"') {
+      scratch.clear();
+      lex.string(scratch);
+    } else {
+      const char *token;
+      size_t len;
+      lex.token(token, len);
+    }
+    // 读完一个数据，等着它的 quote 随之结束
+    while (!open.empty() && open.back().quote) open.pop_back();
+  }
 }
 
-Syntax readSyntax(std::istream &is) {
-  return readItem(readSpace(is));
+} // namespace
+
+// no leading space
+Syntax readItem(Lexer &lex) {
+  static Sym quote_sym = intern("quote");
+  // 暂存区在各次读取之间复用
+  static std::vector<OpenList> open;
+  static std::vector<Syntax> items;
+  open.clear();
+  items.clear();
+  while (true) {
+    Syntax item(nullptr);
+    int c = lex.peek();
+    if (c == '(' || c == '[' || c == '\'') {
+      lex.advance();
+      if (open.size() >= max_read_depth) {
+        open.push_back({0, c == '\''});
+        skipNested(lex, open);
+        throw RuntimeError("Nesting too deep");
+      }
+      open.push_back({items.size(), c == '\''});
+      if (c == '\'') {
+        // 'x 读作 (quote x)
+        items.push_back(Syntax(syntax_arena.make<SymbolSyntax>(quote_sym)));
+      }
+    } else if (c == '"') {
+      // 处理字符串字面量
+      lex.advance(); // 消费开始的双引号
+      std::string str;
+      lex.string(str);
+      item = Syntax(syntax_arena.make<StringSyntax>(str));
+    } else {
+      item = readAtom(lex, c);
+    }
+    
+    // 把读完的数据放进外层的表，并闭合所有随之结束的表
+    while (true) {
+      if (item.get() != nullptr) {
+        if (open.empty()) return item;
+        items.push_back(item);
+        if (open.back().quote) {
+          item = closeList(items, open.back().start);
+          open.pop_back();
+          continue;
+        }
+        item = Syntax(nullptr);
+      }
+      // 读取单引号后的语法元素，或表中的下一个元素
+      lex.skipSpace();
+      if (open.back().quote) break;
+      c = lex.peek();
+      if (c == ')' || c == ']') {
+        lex.advance();
+        item = closeList(items, open.back().start);
+        open.pop_back();
+        continue;
+      }
+      if (c == EOF) {
+        throw RuntimeError("Unexpected end of input");
+      }
+      break;
+    }
+  }
 }
 
-std::istream &operator>>(std::istream &is, Syntax &stx) {
-  stx = readSyntax(is);
-  return is;
+Syntax readSyntax(Lexer &lex) {
+  syntax_arena.reset();
+  lex.skipSpace();
+  if (lex.peek() == EOF) {
+    return Syntax(nullptr);
+  }
+  return readItem(lex);
 }
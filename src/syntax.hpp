@@ -2,66 +2,171 @@
 #define SYNTAX
 
 #include <cstring>
-#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
 #include <vector>
 #include "Def.hpp"
+#include "bigint.hpp"
+#include "lexer.hpp"
 
+/**
+ * @brief Base of the syntax nodes
+ *
+ * Nodes live in the syntax arena and are never deleted one by one, so the
+ * destructor is not virtual; see SyntaxArena.
+ */
 struct SyntaxBase {
-    virtual Expr parse(Assoc &) = 0;
+    SyntaxType s_type;
+    SyntaxBase(SyntaxType t) : s_type(t) {}
+    virtual Expr parse(Scope &) = 0;
     virtual void show(std::ostream &) = 0;
-    virtual ~SyntaxBase() = default;
 };
 
 struct Syntax {
-    std::shared_ptr<SyntaxBase> ptr;
+    SyntaxBase *ptr;
     Syntax(SyntaxBase *);
     SyntaxBase* operator->() const;
     SyntaxBase& operator*();
     SyntaxBase* get() const;
-    Expr parse(Assoc &);
+    Expr parse(Scope &);
+    template <class T> T *as() const;   ///< Checked downcast, nullptr if the tag differs
 };
 
 struct Number : SyntaxBase {
+    static const SyntaxType tag = S_NUMBER;
     int n;
     Number(int);
-    virtual Expr parse(Assoc &) override;
+    virtual Expr parse(Scope &) override;
+    virtual void show(std::ostream &) override;
+};
+
+struct BigNumber : SyntaxBase {
+    static const SyntaxType tag = S_BIGNUM;
+    BigInt n;
+    BigNumber(const BigInt &);
+    virtual Expr parse(Scope &) override;
+    virtual void show(std::ostream &) override;
+};
+
+struct FlonumSyntax : SyntaxBase {
+    static const SyntaxType tag = S_FLONUM;
+    double d;
+    FlonumSyntax(double);
+    virtual Expr parse(Scope &) override;
     virtual void show(std::ostream &) override;
 };
 
 struct TrueSyntax : SyntaxBase {
+    static const SyntaxType tag = S_TRUE;
     // This will not match
-    virtual Expr parse(Assoc &) override;
+    TrueSyntax();
+    virtual Expr parse(Scope &) override;
     virtual void show(std::ostream &) override;
 };
 
 struct FalseSyntax : SyntaxBase {
-    // FalseSyntax();
-    virtual Expr parse(Assoc &) override;
+    static const SyntaxType tag = S_FALSE;
+    FalseSyntax();
+    virtual Expr parse(Scope &) override;
     virtual void show(std::ostream &) override;
 };
 
 struct SymbolSyntax : SyntaxBase {
-    std::string s;
-    SymbolSyntax(const std::string &);
-    virtual Expr parse(Assoc &) override;
+    static const SyntaxType tag = S_SYMBOL;
+    Sym s;
+    SymbolSyntax(Sym);
+    virtual Expr parse(Scope &) override;
     virtual void show(std::ostream &) override;
 };
 
 struct StringSyntax : SyntaxBase {
+    static const SyntaxType tag = S_STRING;
     std::string s;
     StringSyntax(const std::string &);
-    virtual Expr parse(Assoc &) override;
+    virtual Expr parse(Scope &) override;
     virtual void show(std::ostream &) override;
 };
 
+/**
+ * @brief Elements of a List, an array in the syntax arena
+ */
+struct SyntaxList {
+    Syntax *items;
+    size_t count;
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    const Syntax &operator[](size_t i) const { return items[i]; }
+    const Syntax *begin() const { return items; }
+    const Syntax *end() const { return items + count; }
+    const Syntax &front() const { return items[0]; }
+    const Syntax &back() const { return items[count - 1]; }
+};
+
 struct List : SyntaxBase {
-    std::vector<Syntax> stxs;
-    List();
-    virtual Expr parse(Assoc &) override;
+    static const SyntaxType tag = S_LIST;
+    SyntaxList stxs;
+    List(Syntax *, size_t);
+    virtual Expr parse(Scope &) override;
     virtual void show(std::ostream &) override;
 };
 
-Syntax readSyntax(std::istream &);
+template <class T> inline T *Syntax::as() const {
+    return ptr->s_type == T::tag ? static_cast<T*>(ptr) : nullptr;
+}
+
+/**
+ * @brief Bump allocator holding the syntax tree of the datum being read
+ *
+ * A syntax tree only lives from reading a datum to parsing it: the parser
+ * copies out everything the expression keeps, quoted data included. Nodes
+ * and element arrays are therefore carved out of large blocks and dropped
+ * all at once by reset(), which readSyntax calls before reading the next
+ * datum. The few nodes that own heap memory themselves (string literals and
+ * big integers) are recorded and destroyed then.
+ */
+class SyntaxArena {
+public:
+    SyntaxArena();
+    ~SyntaxArena();
+
+    template <class T, class... Args> T *make(Args &&... args) {
+        T *node = new (allocate(sizeof(T))) T(std::forward<Args>(args)...);
+        if (!std::is_trivially_destructible<T>::value) {
+            finalizers.push_back({node, [](void *p) { static_cast<T *>(p)->~T(); }});
+        }
+        return node;
+    }
+    Syntax *array(size_t);      ///< Room for n elements, left uninitialized
+    void reset();               ///< Destroy every node, keeping the first block
+
+private:
+    struct Block {
+        char *data;
+        size_t size;
+    };
+    std::vector<Block> blocks;
+    size_t current;             ///< Block being carved
+    char *cur, *end;
+    std::vector<std::pair<void *, void (*)(void *)>> finalizers;
+
+    void *allocate(size_t);
+    void grow(size_t);
+    SyntaxArena(const SyntaxArena &);
+    SyntaxArena &operator=(const SyntaxArena &);
+};
+
+extern SyntaxArena syntax_arena;
+
+/**
+ * @brief Read the next datum, or a null Syntax at the end of input
+ *
+ * The tree of the previous datum is released first. Nested lists are read
+ * with an explicit stack, so the nesting depth is bounded only by
+ * max_read_depth; a datum nested deeper is skipped and reported as a
+ * RuntimeError.
+ */
+Syntax readSyntax(Lexer &);
 
-std::istream &operator>>(std::istream &, Syntax);
+extern size_t max_read_depth;   ///< Deepest nesting of lists and quotes, set with --read-depth
 #endif
\ No newline at end of file
@@ -7,182 +7,219 @@
  */
 
 #include "value.hpp"
+#include "bytecode.hpp"
+#include "closure.hpp"
+#include "RE.hpp"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <unordered_map>
 
 // ============================================================================
 // Base ValueBase Implementation
 // ============================================================================
 
-ValueBase::ValueBase(ValueType vt) : v_type(vt) {}
+ValueBase::ValueBase(ValueType vt) : immutable(false), print_state(0), v_type(vt) {}
 
-void ValueBase::showCdr(std::ostream &os) {
-    os << " . ";
-    show(os);
-    os << ')';
+// ============================================================================
+// Tagged Value Implementation
+// ============================================================================
+
+void Value::show(Writer &os) const {
+    switch (bits) {
+        case IMM_FALSE: os << "#f"; return;
+        case IMM_TRUE: os << "#t"; return;
+        case IMM_NULL: os << "()"; return;
+        case IMM_VOID: os << "#<void>"; return;
+        case IMM_TERMINATE: os << "()"; return;
+    }
+    if (bits & 1) {
+        os << fixnum();
+    } else {
+        get()->show(os);
+    }
 }
 
 // ============================================================================
-// Value Smart Pointer Implementation
+// Environment (Frame) Implementation
 // ============================================================================
 
-Value::Value(ValueBase *ptr) : ptr(ptr) {}
+Frame::Frame(int size, const Assoc &parent) : size(size), parent(parent) {}
 
-ValueBase* Value::operator->() const { 
-    return ptr.get(); 
+void Frame::trace() {
+    gcMark(parent);
+    Value *s = slots();
+    for (int i = 0; i < size; i++) {
+        gcMark(s[i]);
+    }
 }
 
-ValueBase& Value::operator*() { 
-    return *ptr; 
+void Frame::operator delete(void *p) {
+    // 与 extend 中的分配对应（帧的实际大小包含槽位）
+    ::operator delete(p);
 }
 
-ValueBase* Value::get() const { 
-    return ptr.get(); 
+Assoc empty() {
+    return Assoc(nullptr);
 }
 
-void Value::show(std::ostream &os) {
-    ptr->show(os);
+Assoc extend(int size, Assoc &parent) {
+    // 帧头与所有槽位在同一次分配中
+    void *mem = ::operator new(sizeof(Frame) + size * sizeof(Value));
+    Frame *frame = new (mem) Frame(size, parent);
+    Value *slots = frame->slots();
+    for (int i = 0; i < size; i++) {
+        new (&slots[i]) Value(nullptr);
+    }
+    return Assoc(frame);
 }
 
 // ============================================================================
-// Environment (Association List) Implementation
+// Scope Implementation
 // ============================================================================
 
-AssocList::AssocList(const std::string &x, const Value &v, Assoc &next)
-    : x(x), v(v), next(next) {}
+Scope::Scope() : parent(nullptr) {}
 
-Assoc::Assoc(AssocList *x) : ptr(x) {}
+Scope::Scope(const std::vector<Sym> &names, Scope *parent) : names(names), parent(parent) {}
 
-AssocList* Assoc::operator->() const { 
-    return ptr.get(); 
+bool Scope::isGlobal() const {
+    return parent == nullptr;
 }
 
-AssocList& Assoc::operator*() { 
-    return *ptr; 
+bool Scope::lookup(Sym x, int &depth, int &index) const {
+    depth = 0;
+    for (const Scope *s = this; !s->isGlobal(); s = s->parent, depth++) {
+        // 同名时后出现的绑定生效
+        for (int i = (int)s->names.size() - 1; i >= 0; i--) {
+            if (s->names[i] == x) {
+                index = i;
+                return true;
+            }
+        }
+    }
+    depth = -1;  // 未找到：全局变量
+    return false;
 }
 
-AssocList* Assoc::get() const { 
-    return ptr.get(); 
-}
+// ============================================================================
+// Global Environment Implementation
+// ============================================================================
 
-Assoc empty() {
-    return Assoc(nullptr);
-}
+GlobalCell::GlobalCell(Sym name) : name(name), v(nullptr) {}
 
-Assoc extend(const std::string &x, const Value &v, Assoc &lst) {
-    return Assoc(new AssocList(x, v, lst));
+std::vector<GlobalCell *> &globalCells() {
+    // Every cell ever created, in creation order; the collector's roots
+    static std::vector<GlobalCell *> cells;
+    return cells;
 }
 
-void modify(const std::string &x, const Value &v, Assoc &lst) {
-    for (auto i = lst; i.get() != nullptr; i = i->next) {
-        if (x == i->x) {
-            i->v = v;
-            return;
-        }
+GlobalCell *globalCell(Sym name) {
+    // The cell hangs off the symbol entry and is never removed
+    if (name->cell == nullptr) {
+        name->cell = new GlobalCell(name);
+        globalCells().push_back(name->cell);
     }
-}
-
-Value find(const std::string &x, Assoc &l) {
-    for (auto i = l; i.get() != nullptr; i = i->next) {
-        if (x == i->x) {
-            return i->v;
-        }
-    }
-    return Value(nullptr);
+    return name->cell;
 }
 
 // ============================================================================
 // Simple Value Types Implementation
 // ============================================================================
 
-// Void
-Void::Void() : ValueBase(V_VOID) {}
+// Bignum
+Bignum::Bignum(const BigInt &n) : ValueBase(V_BIGNUM), n(n) {}
 
-void Void::show(std::ostream &os) {
-    os << "#<void>";
+void Bignum::show(Writer &os) {
+    os << n.toString();
 }
 
-Value VoidV() {
-    return Value(new Void());
-}
-
-// Integer
-Integer::Integer(int n) : ValueBase(V_INT), n(n) {}
-
-void Integer::show(std::ostream &os) {
-    os << n;
+Value BignumV(const BigInt &n) {
+    return Value(new Bignum(n));
 }
 
-Value IntegerV(int n) {
-    return Value(new Integer(n));
+Value ExactIntegerV(const BigInt &n) {
+    if (n.fitsInt()) return IntegerV(n.toInt());
+    return BignumV(n);
 }
 
 // Rational
-// Helper function to calculate greatest common divisor
-static int gcd(int a, int b) {
-    if (a < 0) a = -a;
-    if (b < 0) b = -b;
-    while (b != 0) {
-        int temp = b;
-        b = a % b;
-        a = temp;
-    }
-    return a;
-}
+Rational::Rational(const Ratio &q) : ValueBase(V_RATIONAL), q(q) {}
 
-Rational::Rational(int num, int den) : ValueBase(V_RATIONAL) {
-    if (den == 0) {
-        throw std::runtime_error("Division by zero");
-    }
-    
-    // Simplify the fraction
-    int g = gcd(num, den);
-    numerator = num / g;
-    denominator = den / g;
-    
-    // Ensure denominator is positive
-    if (denominator < 0) {
-        numerator = -numerator;
-        denominator = -denominator;
-    }
+void Rational::show(Writer &os) {
+    os << q.num.toString() << "/" << q.den.toString();
 }
 
-void Rational::show(std::ostream &os) {
-    if (denominator == 1) {
-        os << numerator;
-    } else {
-        os << numerator << "/" << denominator;
-    }
+Value RationalV(const Ratio &q) {
+    return Value(new Rational(q));
 }
 
-Value RationalV(int num, int den) {
-    return Value(new Rational(num, den));
+Value ExactRationalV(const Ratio &q) {
+    if (q.isInteger()) return ExactIntegerV(q.num);
+    return RationalV(q);
 }
 
-// Boolean
-Boolean::Boolean(bool b) : ValueBase(V_BOOL), b(b) {}
+// Flonum
+Flonum::Flonum(double d) : ValueBase(V_FLONUM), d(d) {}
 
-void Boolean::show(std::ostream &os) {
-    os << (b ? "#t" : "#f");
+void Flonum::show(Writer &os) {
+    if (d != d) {
+        os << "+nan.0";
+        return;
+    }
+    if (std::isinf(d)) {
+        os << (d > 0 ? "+inf.0" : "-inf.0");
+        return;
+    }
+    // 取能还原出同一个 double 的最短有效数字
+    char buf[32];
+    int precision = 1;
+    for (; precision < 17; precision++) {
+        snprintf(buf, sizeof(buf), "%.*e", precision - 1, d);
+        if (strtod(buf, nullptr) == d) break;
+    }
+    snprintf(buf, sizeof(buf), "%.*e", precision - 1, d);
+    // buf 形如 -d.ddde+XX：拆出数字串和十进制指数
+    std::string digits;
+    const char *c = buf;
+    if (*c == '-') {
+        os << '-';
+        c++;
+    }
+    for (; *c != 'e'; c++) {
+        if (*c != '.') digits.push_back(*c);
+    }
+    int exponent = atoi(c + 1);
+    if (exponent < -7 || exponent >= 21) {
+        os << digits[0] << '.' << (digits.size() > 1 ? digits.substr(1) : "0") << 'e' << exponent;
+    } else if (exponent < 0) {
+        os << "0." << std::string(-exponent - 1, '0') << digits;
+    } else if (exponent + 1 >= (int)digits.size()) {
+        os << digits << std::string(exponent + 1 - digits.size(), '0') << ".0";
+    } else {
+        os << digits.substr(0, exponent + 1) << '.' << digits.substr(exponent + 1);
+    }
 }
 
-Value BooleanV(bool b) {
-    return Value(new Boolean(b));
+Value FlonumV(double d) {
+    return Value(new Flonum(d));
 }
 
 // Symbol
-Symbol::Symbol(const std::string &s) : ValueBase(V_SYM), s(s) {}
+Symbol::Symbol(Sym s) : ValueBase(V_SYM), s(s) {}
 
-void Symbol::show(std::ostream &os) {
-    os << s;
+void Symbol::show(Writer &os) {
+    os << s->name;
 }
 
-Value SymbolV(const std::string &s) {
+Value SymbolV(Sym s) {
     return Value(new Symbol(s));
 }
 
 // String
 String::String(const std::string &s) : ValueBase(V_STRING), s(s) {}
 
-void String::show(std::ostream &os) {
+void String::show(Writer &os) {
     os << "\"" << s << "\"";
 }
 
@@ -191,51 +228,183 @@ Value StringV(const std::string &s) {
 }
 
 // ============================================================================
-// Special Value Types Implementation
+// Composite Value Types Implementation
 // ============================================================================
 
-// Null
-Null::Null() : ValueBase(V_NULL) {}
+// Pair
+Pair::Pair(const Value &car, const Value &cdr) 
+    : ValueBase(V_PAIR), car(car), cdr(cdr) {}
 
-void Null::show(std::ostream &os) {
-    os << "()";
-}
+namespace {
 
-void Null::showCdr(std::ostream &os) {
-    os << ')';
-}
+// print_state 的取值：深度优先遍历的颜色，加上数据标签的标志位
+enum : uint8_t {
+    PRINT_GRAY = 1,         // 在当前遍历路径上
+    PRINT_BLACK = 2,        // 已经遍历完
+    PRINT_CYCLIC = 4,       // 被自己的后代引用，需要数据标签
+    PRINT_LABELED = 8       // 标签 #n= 已经输出
+};
 
-Value NullV() {
-    return Value(new Null());
+/**
+ * @brief A stretch of a cdr chain that is on the current traversal path
+ *
+ * Every pair from head to cur along the cdrs is gray. Only a car that is
+ * itself a pair opens a new run, so the explicit stack grows with the
+ * nesting depth of the list, not with its length.
+ */
+struct PrintRun {
+    Pair *head;
+    Pair *cur;
+};
+
+// 遍历中遇到序对 p：p 在当前路径上说明找到了环。返回 p 是否第一次遇到
+bool firstVisit(Pair *p) {
+    if (p->print_state & PRINT_GRAY) p->print_state |= PRINT_CYCLIC;
+    return p->print_state == 0;
+}
+
+// 从第一次遇到的 p 开始，沿 car 链进入每个还没遇到的序对
+void enterCars(std::vector<PrintRun> &runs, Pair *p) {
+    while (true) {
+        p->print_state = PRINT_GRAY;
+        runs.push_back({p, p});
+        Pair *car = p->car.as<Pair>();
+        if (car == nullptr || !firstVisit(car)) return;
+        p = car;
+    }
 }
 
-// Terminate
-Terminate::Terminate() : ValueBase(V_TERMINATE) {}
+// 第一遍：标记所有环回到的序对
+void markCycles(Pair *root) {
+    std::vector<PrintRun> runs;
+    enterCars(runs, root);
+    while (!runs.empty()) {
+        PrintRun &run = runs.back();
+        Pair *next = run.cur->cdr.as<Pair>();
+        if (next != nullptr && firstVisit(next)) {
+            next->print_state = PRINT_GRAY;
+            run.cur = next;
+            Pair *car = next->car.as<Pair>();
+            if (car != nullptr && firstVisit(car)) enterCars(runs, car);
+            continue;
+        }
+        // 这段 cdr 链走完，整段离开遍历路径
+        for (Pair *p = run.head;; p = p->cdr.as<Pair>()) {
+            p->print_state = (p->print_state & PRINT_CYCLIC) | PRINT_BLACK;
+            if (p == run.cur) break;
+        }
+        runs.pop_back();
+    }
+}
 
-void Terminate::show(std::ostream &os) {
-    os << "()";
+// 最后一遍：清掉所有标记，只进入还带着标记的序对
+void clearMarks(Pair *root) {
+    std::vector<Pair *> pending(1, root);
+    while (!pending.empty()) {
+        Pair *p = pending.back();
+        pending.pop_back();
+        while (p != nullptr && p->print_state != 0) {
+            p->print_state = 0;
+            Pair *car = p->car.as<Pair>();
+            if (car != nullptr && car->print_state != 0) pending.push_back(car);
+            p = p->cdr.as<Pair>();
+        }
+    }
 }
 
-Value TerminateV() {
-    return Value(new Terminate());
+} // namespace
+
+void Pair::show(Writer &os) {
+    markCycles(this);
+    // 第二遍：输出。tails 保存每个还没闭合的表剩下的部分
+    std::vector<Value> tails;
+    std::unordered_map<Pair *, int> labels;
+    Value cur(this);
+    while (true) {
+        Pair *p = cur.as<Pair>();
+        if (p == nullptr) {
+            cur.show(os);
+        } else if (p->print_state & PRINT_LABELED) {
+            os << '#' << labels[p] << '#';
+        } else {
+            if (p->print_state & PRINT_CYCLIC) {
+                int label = (int)labels.size();
+                labels[p] = label;
+                os << '#' << label << '=';
+                p->print_state |= PRINT_LABELED;
+            }
+            os << '(';
+            tails.push_back(p->cdr);
+            cur = p->car;
+            continue;
+        }
+        // 当前元素输出完毕，接着输出外层表的下一个元素
+        bool more = false;
+        while (!more && !tails.empty()) {
+            Value &rest = tails.back();
+            Pair *next = rest.as<Pair>();
+            if (rest.bits == IMM_NULL) {
+                os << ')';
+                tails.pop_back();
+            } else if (next != nullptr && !(next->print_state & PRINT_CYCLIC)) {
+                os << ' ';
+                cur = next->car;
+                rest = next->cdr;
+                more = true;
+            } else {
+                // 不是表的结尾，或者标签必须写在 ( 之前，都用点对形式
+                os << " . ";
+                cur = rest;
+                rest = NullV();
+                more = true;
+            }
+        }
+        if (!more) break;
+    }
+    clearMarks(this);
 }
 
-// ============================================================================
-// Composite Value Types Implementation
-// ============================================================================
+namespace {
 
-// Pair
-Pair::Pair(const Value &car, const Value &cdr) 
-    : ValueBase(V_PAIR), car(car), cdr(cdr) {}
+const size_t PAIR_SLAB_CELLS = 4096;
+
+// 释放的单元中原来的内容已经没用，直接拿来存放空闲链表的指针
+struct FreePair {
+    FreePair *next;
+};
+
+char *pair_next = nullptr;          // 当前块中下一个未用过的单元
+char *pair_end = nullptr;
+FreePair *pair_free = nullptr;
+
+} // namespace
 
-void Pair::show(std::ostream &os) {
-    os << '(' << car;
-    cdr->showCdr(os);
+void *Pair::operator new(size_t) {
+    if (pair_free != nullptr) {
+        FreePair *cell = pair_free;
+        pair_free = cell->next;
+        return cell;
+    }
+    if (pair_next == pair_end) {
+        // 块一直保留到程序结束，其中的单元经空闲链表反复使用
+        pair_next = static_cast<char *>(malloc(PAIR_SLAB_CELLS * sizeof(Pair)));
+        if (pair_next == nullptr) throw std::bad_alloc();
+        pair_end = pair_next + PAIR_SLAB_CELLS * sizeof(Pair);
+    }
+    void *cell = pair_next;
+    pair_next += sizeof(Pair);
+    return cell;
 }
 
-void Pair::showCdr(std::ostream &os) {
-    os << ' ' << car;
-    cdr->showCdr(os);
+void Pair::operator delete(void *p) {
+    FreePair *cell = static_cast<FreePair *>(p);
+    cell->next = pair_free;
+    pair_free = cell;
+}
+
+void Pair::trace() {
+    gcMark(car);
+    gcMark(cdr);
 }
 
 Value PairV(const Value &car, const Value &cdr) {
@@ -243,22 +412,48 @@ Value PairV(const Value &car, const Value &cdr) {
 }
 
 // Procedure
-Procedure::Procedure(const std::vector<std::string> &xs, const Expr &e, const Assoc &env)
-    : ValueBase(V_PROC), parameters(xs), e(e), env(env) {}
+Procedure::Procedure(const std::vector<Sym> &xs, const Expr &e, const Assoc &env)
+    : ValueBase(V_PROC), parameters(xs), e(e), env(env), code(nullptr), compiled(nullptr) {}
 
-void Procedure::show(std::ostream &os) {
+void Procedure::show(Writer &os) {
     os << "#<procedure>";
 }
 
-Value ProcedureV(const std::vector<std::string> &xs, const Expr &e, const Assoc &env) {
+void Procedure::trace() {
+    gcMark(e);
+    gcMark(env);
+    gcMark(code);
+    gcMark(compiled);
+}
+
+Value ProcedureV(const std::vector<Sym> &xs, const Expr &e, const Assoc &env) {
     return Value(new Procedure(xs, e, env));
 }
 
+// Primitive
+Primitive::Primitive(Sym name, int arity, const Expr &body, Fn fn)
+    : ValueBase(V_PRIMITIVE), name(name), arity(arity), body(body), fn(fn) {}
+
+Value Primitive::apply(Value *args, int argc) {
+    if (arity >= 0 && argc != arity) {
+        throw RuntimeError("Wrong number of arguments");
+    }
+    return fn(this, args, argc);
+}
+
+void Primitive::show(Writer &os) {
+    os << "#<procedure>";
+}
+
+void Primitive::trace() {
+    gcMark(body);
+}
+
 // ============================================================================
 // Utility Functions Implementation
 // ============================================================================
 
-std::ostream &operator<<(std::ostream &os, Value &v) {
-    v->show(os);
+Writer &operator<<(Writer &os, Value &v) {
+    v.show(os);
     return os;
 }
@@ -10,169 +10,208 @@
  */
 
 #include "Def.hpp"
+#include "gc.hpp"
 #include "expr.hpp"
+#include "bigint.hpp"
+#include "rational.hpp"
+#include "writer.hpp"
+#include <climits>
 #include <memory>
 #include <cstring>
+#include <cstdint>
 #include <vector>
 
 // ============================================================================
-// Base classes and smart pointer wrappers
+// Base classes and handles
 // ============================================================================
 
 /**
- * @brief Base class for all values in the Scheme interpreter
+ * @brief Base class for all heap-allocated values in the Scheme interpreter
  */
-struct ValueBase {
+struct ValueBase : GCObject {
+    bool immutable;     ///< Part of a quoted constant, which must not be modified
+    uint8_t print_state;    ///< Scratch mark of the list printer, 0 outside of printing
     ValueType v_type;
     ValueBase(ValueType);
-    virtual void show(std::ostream &) = 0;
-    virtual void showCdr(std::ostream &);
+    virtual void show(Writer &) = 0;
     virtual ~ValueBase() = default;
 };
 
-/**
- * @brief Smart pointer wrapper for ValueBase objects
- */
-struct Value {
-    std::shared_ptr<ValueBase> ptr;
-    Value(ValueBase *);
-    void show(std::ostream &);
-    ValueBase* operator->() const;
-    ValueBase& operator*();
-    ValueBase* get() const;
-};
-
 // ============================================================================
-// Environment (Association Lists)
+// Environment (Frames)
 // ============================================================================
 
 /**
- * @brief Smart pointer wrapper for AssocList (Environment)
+ * @brief Handle to a Frame (Environment), nullptr for the global environment
  */
 struct Assoc {
-    std::shared_ptr<AssocList> ptr;
-    Assoc(AssocList *);
-    AssocList* operator->() const;
-    AssocList& operator*();
-    AssocList* get() const;
+    Frame *ptr;
+    Assoc(Frame *);
+    Frame* operator->() const;
+    Frame& operator*();
+    Frame* get() const;
 };
 
 /**
- * @brief Association list node for variable bindings
+ * @brief Environment frame holding every binding of one procedure call,
+ * let, letrec or body with internal definitions
+ *
+ * The slots are stored right after the header, in the same allocation.
  */
-struct AssocList {
-    std::string x;      ///< Variable name
-    Value v;            ///< Variable value
-    Assoc next;         ///< Next binding in the chain
-    AssocList(const std::string &, const Value &, Assoc &);
+struct Frame : GCObject {
+    int size;           ///< Number of slots
+    Assoc parent;       ///< Enclosing frame
+    Frame(int, const Assoc &);
+    Value *slots();
+    virtual void trace() override;
+    static void operator delete(void *);
 };
 
 // Environment operations
 Assoc empty();
-Assoc extend(const std::string&, const Value &, Assoc &);
-void modify(const std::string&, const Value &, Assoc &);
-Value find(const std::string &, Assoc &);
+Assoc extend(int, Assoc &);
+Value &bindingAt(int, int, Assoc &);
 
-// ============================================================================
-// Simple Value Types
-// ============================================================================
+/**
+ * @brief Compile-time counterpart of a Frame
+ *
+ * The parser opens one Scope for every frame the evaluator will create,
+ * recording the slot names in order, so that each variable can be resolved
+ * to a (frame depth, slot index) address once. The outermost scope stands
+ * for the global environment and has no frame.
+ */
+struct Scope {
+    std::vector<Sym> names;           ///< Slot names of the frame
+    Scope *parent;                    ///< Enclosing scope, nullptr for the global scope
+    Scope();
+    Scope(const std::vector<Sym> &, Scope *);
+    bool isGlobal() const;
+    bool lookup(Sym, int &, int &) const;
+};
 
 /**
- * @brief Void value (represents no meaningful return value)
+ * @brief Global variable cell
+ *
+ * Top-level definitions live in a table of cells instead of the association
+ * list, so a global reference is resolved to its cell once at parse time.
+ * The cell holds Value(nullptr) while the variable is unbound.
  */
-struct Void : ValueBase {
-    Void();
-    virtual void show(std::ostream &) override;
+struct GlobalCell {
+    Sym name;           ///< Variable name
+    Value v;            ///< Current value
+    GlobalCell(Sym);
 };
-Value VoidV();
+
+GlobalCell *globalCell(Sym);
+std::vector<GlobalCell *> &globalCells();
+
+// ============================================================================
+// Immediate Value Types
+// ============================================================================
+
+Value VoidV();          ///< Void value (represents no meaningful return value)
+Value IntegerV(int);    ///< Fixnum
+Value BooleanV(bool);   ///< #t or #f
+Value NullV();          ///< Empty list
+Value TerminateV();     ///< Termination signal
+Value TailCallV();      ///< Marker returned by a tail call, never visible to programs
+
+Value ExactIntegerV(long long);         ///< Exact integer, a fixnum whenever it fits
+Value ExactIntegerV(const BigInt &);    ///< Exact integer, a fixnum whenever it fits
+
+// ============================================================================
+// Simple Value Types
+// ============================================================================
 
 /**
- * @brief Integer value
+ * @brief Exact integer outside the fixnum range
+ *
+ * Integer arithmetic promotes to a Bignum when a result overflows a fixnum
+ * and demotes back as soon as it fits, so a Bignum never holds a value that
+ * has a fixnum encoding.
  */
-struct Integer : ValueBase {
-    int n;
-    Integer(int);
-    virtual void show(std::ostream &) override;
+struct Bignum : ValueBase {
+    static const ValueType tag = V_BIGNUM;
+    BigInt n;
+    Bignum(const BigInt &);
+    virtual void show(Writer &) override;
 };
-Value IntegerV(int);
+Value BignumV(const BigInt &);
 
 /**
  * @brief Rational number value
+ *
+ * Always a proper fraction in lowest terms: a quotient whose denominator
+ * reduces to 1 is represented as an exact integer instead.
  */
 struct Rational : ValueBase {
-    int numerator;
-    int denominator;
-    Rational(int, int);
-    virtual void show(std::ostream &) override;
+    static const ValueType tag = V_RATIONAL;
+    Ratio q;
+    Rational(const Ratio &);
+    virtual void show(Writer &) override;
 };
-Value RationalV(int, int);
+Value RationalV(const Ratio &);
+Value ExactRationalV(const Ratio &);    ///< Exact integer when the denominator is 1
 
 /**
- * @brief Boolean value
+ * @brief Inexact real number
  */
-struct Boolean : ValueBase {
-    bool b;
-    Boolean(bool);
-    virtual void show(std::ostream &) override;
+struct Flonum : ValueBase {
+    static const ValueType tag = V_FLONUM;
+    double d;
+    Flonum(double);
+    virtual void show(Writer &) override;
 };
-Value BooleanV(bool);
+Value FlonumV(double);
 
 /**
  * @brief Symbol value
  */
 struct Symbol : ValueBase {
-    std::string s;
-    Symbol(const std::string &);
-    virtual void show(std::ostream &) override;
+    static const ValueType tag = V_SYM;
+    Sym s;              ///< Interned name; eq? compares these pointers
+    Symbol(Sym);
+    virtual void show(Writer &) override;
 };
-Value SymbolV(const std::string &);
+Value SymbolV(Sym);
 
 /**
  * @brief String value
  */
 struct String : ValueBase {
+    static const ValueType tag = V_STRING;
     std::string s;
     String(const std::string &);
-    virtual void show(std::ostream &) override;
+    virtual void show(Writer &) override;
 };
 Value StringV(const std::string &);
 
-// ============================================================================
-// Special Value Types
-// ============================================================================
-
-/**
- * @brief Null value (empty list)
- */
-struct Null : ValueBase {
-    Null();
-    virtual void show(std::ostream &) override;
-    virtual void showCdr(std::ostream &) override;
-};
-Value NullV();
-
-/**
- * @brief Termination signal value
- */
-struct Terminate : ValueBase {
-    Terminate();
-    virtual void show(std::ostream &) override;
-};
-Value TerminateV();
-
 // ============================================================================
 // Composite Value Types
 // ============================================================================
 
 /**
  * @brief Pair value (cons cell)
+ *
+ * Lists are printed without recursion, in time linear in the number of
+ * pairs. A pair that is reached again through its own car or cdr is printed
+ * with a datum label, as in #0=(1 2 . #0#); shared structure without a
+ * cycle is printed in full at each occurrence.
+ *
+ * Pairs are by far the most numerous objects, so they come from a pool of
+ * their own: cells are carved from large slabs, packed next to each other,
+ * and cells freed by the collector are reused before the slab grows. Pair
+ * is final, so every cell the pool hands out is exactly sizeof(Pair).
  */
-struct Pair : ValueBase {
+struct Pair final : ValueBase {
+    static const ValueType tag = V_PAIR;
     Value car;  ///< First element
     Value cdr;  ///< Second element
     Pair(const Value &, const Value &);
-    virtual void show(std::ostream &) override;
-    virtual void showCdr(std::ostream &) override;
+    virtual void show(Writer &) override;
+    virtual void trace() override;
+    static void *operator new(size_t);
+    static void operator delete(void *);
 };
 Value PairV(const Value &, const Value &);
 
@@ -180,21 +219,229 @@ Value PairV(const Value &, const Value &);
  * @brief Procedure (function) value
  */
 struct Procedure : ValueBase {
-    std::vector<std::string> parameters;   ///< Parameter names
+    static const ValueType tag = V_PROC;
+    std::vector<Sym> parameters;           ///< Parameter names
     Expr e;                                ///< Function body expression
     Assoc env;                             ///< Closure environment
-    Procedure(const std::vector<std::string> &, const Expr &, const Assoc &);
-    virtual void show(std::ostream &) override;
+    Code *code;                            ///< Compiled body, nullptr until the VM needs it
+    Callable *compiled;                    ///< Body for the closure engine, nullptr until needed
+    Procedure(const std::vector<Sym> &, const Expr &, const Assoc &);
+    virtual void show(Writer &) override;
+    virtual void trace() override;
+};
+Value ProcedureV(const std::vector<Sym> &, const Expr &, const Assoc &);
+
+/**
+ * @brief Built-in procedure, preallocated once for every primitive
+ *
+ * Calling it goes straight to fn with the evaluated arguments, without a
+ * frame or a body to evaluate.
+ */
+struct Primitive : ValueBase {
+    static const ValueType tag = V_PRIMITIVE;
+    typedef Value (*Fn)(Primitive *, Value *, int);
+    Sym name;                              ///< Name of the primitive
+    int arity;                             ///< Number of arguments, -1 for any
+    Expr body;                             ///< Node whose evalRator implements it
+    Fn fn;                                 ///< Applies body to the arguments
+    Primitive(Sym, int, const Expr &, Fn);
+    Value apply(Value *, int);
+    virtual void show(Writer &) override;
+    virtual void trace() override;
 };
-Value ProcedureV(const std::vector<std::string> &, const Expr &, const Assoc &);
 
 // ============================================================================
 // Utility Functions
 // ============================================================================
 
-std::ostream &operator<<(std::ostream &, Value &);
+Writer &operator<<(Writer &, Value &);
 
 // Batch processing for define statements (supporting mutual recursion)
-Value evaluateDefineGroup(const std::vector<std::pair<std::string, Expr>>& defines, Assoc &env);
+Value evaluateDefineGroup(const std::vector<std::pair<Sym, Expr>>& defines, Assoc &env);
+
+/**
+ * @brief Evaluation engines, selected with --engine on the command line
+ */
+enum Engine {
+    ENGINE_VM,          ///< Bytecode virtual machine (default)
+    ENGINE_CLOSURE,     ///< Closure-compilation engine
+    ENGINE_TREE         ///< Reference tree-walking evaluator
+};
+extern Engine engine;
+
+// Evaluate a top-level expression with the selected engine
+Value evaluate(const Expr &, Assoc &);
+
+/**
+ * @brief Most call frames the virtual machine keeps, set with --max-depth
+ *
+ * The machine holds its frames on the heap, so non-tail recursion is bounded
+ * by this cap rather than by the native stack; a call past it raises a
+ * RuntimeError.
+ */
+extern size_t max_eval_depth;
+
+/**
+ * @brief Lowest native stack address evaluation and compilation may reach
+ *
+ * Those engines recurse on the C++ stack once per non-tail call and once
+ * per nested subexpression, and so does the compiler of the closure
+ * engine; the vm compiler only recurses once per nested lambda. Every
+ * call, every node that evaluates a subexpression and every compilation
+ * step checks the stack pointer against this bound, so exhausting the
+ * stack raises a RuntimeError instead of crashing. Zero disables the
+ * check.
+ *
+ * The depth this allows depends on the stack size and the build, so deep
+ * nesting or recursion that the vm engine handles can still raise this
+ * error under the closure and tree engines.
+ */
+extern uintptr_t native_stack_limit;
+
+/**
+ * @brief Set native_stack_limit from the stack size limit of the process,
+ * measured from the caller's frame
+ */
+void initNativeStack();
+
+[[noreturn]] void nativeStackExhausted();
+
+inline void checkNativeStack() {
+    char here;
+    if (reinterpret_cast<uintptr_t>(&here) < native_stack_limit) nativeStackExhausted();
+}
+
+// ============================================================================
+// Inline Value Operations
+// ============================================================================
+// These run on every variable access, frame access and arithmetic operation, so they are
+// kept in the header where the compiler can inline them.
+
+enum {
+    IMM_FALSE     = (0 << 2) | 2,
+    IMM_TRUE      = (1 << 2) | 2,
+    IMM_NULL      = (2 << 2) | 2,
+    IMM_VOID      = (3 << 2) | 2,
+    IMM_TERMINATE = (4 << 2) | 2,
+    IMM_TAILCALL  = (5 << 2) | 2
+};
+
+inline Value::Value(ValueBase *ptr) : bits(reinterpret_cast<uintptr_t>(ptr)) {}
+
+inline Value Value::fromBits(uintptr_t b) {
+    Value v(nullptr);
+    v.bits = b;
+    return v;
+}
+
+inline bool Value::isHeap() const {
+    return (bits & 3) == 0 && bits != 0;
+}
+
+inline bool Value::isUnbound() const {
+    return bits == 0;
+}
+
+inline ValueType Value::type() const {
+    if (bits & 1) return V_INT;
+    if (bits & 2) {
+        switch (bits) {
+            case IMM_FALSE:
+            case IMM_TRUE: return V_BOOL;
+            case IMM_NULL: return V_NULL;
+            case IMM_VOID: return V_VOID;
+            case IMM_TERMINATE: return V_TERMINATE;
+            case IMM_TAILCALL: return V_TAILCALL;
+        }
+    }
+    return get()->v_type;
+}
+
+inline int Value::fixnum() const {
+    return int(intptr_t(bits) >> 1);
+}
+
+inline bool Value::boolean() const {
+    return bits == IMM_TRUE;
+}
+
+inline ValueBase* Value::operator->() const {
+    return reinterpret_cast<ValueBase *>(bits);
+}
+
+inline ValueBase& Value::operator*() {
+    return *get();
+}
+
+inline ValueBase* Value::get() const {
+    return reinterpret_cast<ValueBase *>(bits);
+}
+
+inline bool Value::operator==(const Value &other) const {
+    return bits == other.bits;
+}
+
+inline bool Value::operator!=(const Value &other) const {
+    return bits != other.bits;
+}
+
+template <class T> inline T *Value::as() const {
+    return isHeap() && get()->v_type == T::tag ? static_cast<T*>(get()) : nullptr;
+}
+
+inline Assoc::Assoc(Frame *x) : ptr(x) {}
+
+inline Frame* Assoc::operator->() const {
+    return ptr;
+}
+
+inline Frame& Assoc::operator*() {
+    return *ptr;
+}
+
+inline Frame* Assoc::get() const {
+    return ptr;
+}
+
+inline Value *Frame::slots() {
+    return reinterpret_cast<Value *>(this + 1);
+}
+
+inline Value &bindingAt(int depth, int index, Assoc &l) {
+    Frame *i = l.get();
+    while (depth-- > 0) {
+        i = i->parent.get();
+    }
+    return i->slots()[index];
+}
+
+inline Value IntegerV(int n) {
+    return Value::fromBits((uintptr_t(intptr_t(n)) << 1) | 1);
+}
+
+inline Value ExactIntegerV(long long n) {
+    if (n >= INT_MIN && n <= INT_MAX) return IntegerV(int(n));
+    return BignumV(BigInt(n));
+}
+
+inline Value BooleanV(bool b) {
+    return Value::fromBits(b ? IMM_TRUE : IMM_FALSE);
+}
+
+inline Value NullV() {
+    return Value::fromBits(IMM_NULL);
+}
+
+inline Value VoidV() {
+    return Value::fromBits(IMM_VOID);
+}
+
+inline Value TerminateV() {
+    return Value::fromBits(IMM_TERMINATE);
+}
+
+inline Value TailCallV() {
+    return Value::fromBits(IMM_TAILCALL);
+}
 
 #endif // VALUE
\ No newline at end of file
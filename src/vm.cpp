@@ -0,0 +1,465 @@
+/**
+ * @file vm.cpp
+ * @brief Virtual machine executing compiled bytecode
+ *
+ * The machine keeps its operand stack and call frames on the heap, so only
+ * the size of memory bounds the depth of non-tail recursion. Dispatch uses
+ * computed goto where GCC extensions are available and a switch otherwise.
+ *
+ * A call leaves the procedure just below the frame pointer fp and its
+ * arguments from fp on. Flat code keeps them there as its first frame;
+ * other code moves them into a Frame. Returning puts the result where the
+ * procedure was.
+ */
+
+#include "bytecode.hpp"
+#include "RE.hpp"
+#include <algorithm>
+
+#if defined(__GNUC__)
+#define VM_COMPUTED_GOTO 1
+#endif
+
+namespace {
+
+/**
+ * @brief Return point saved by a non-tail call
+ *
+ * A frame with a null pc marks the entry of a vmEval and holds the registers
+ * of the machine as they were before it.
+ */
+struct CallFrame {
+    Code *code;
+    const int32_t *pc;
+    Assoc env;
+    size_t fp;          // 帧指针在操作数栈中的下标
+};
+
+// 虚拟机状态。寄存器平时保存在 run 的局部变量中，只在安全点之前写回这里
+std::vector<Value> vm_stack;
+size_t vm_top = 0;                  // 操作数栈中已使用的部分
+size_t vm_fp = 0;
+std::vector<CallFrame> vm_frames;
+Code *vm_code = nullptr;
+Assoc vm_env(nullptr);
+
+void markVM(void *) {
+    for (size_t i = 0; i < vm_top; i++) gcMark(vm_stack[i]);
+    for (const CallFrame &frame : vm_frames) {
+        gcMark(frame.code);
+        gcMark(frame.env);
+    }
+    gcMark(vm_code);
+    gcMark(vm_env);
+}
+
+// 栈空间在进入代码时按其最大深度一次性保证
+#define ENSURE_STACK() \
+    if (fp + code->max_stack > stack_end) { \
+        size_t top = sp - vm_stack.data(), base = fp - vm_stack.data(); \
+        vm_stack.resize(std::max(2 * vm_stack.size(), base + code->max_stack), Value(nullptr)); \
+        sp = vm_stack.data() + top; \
+        fp = vm_stack.data() + base; \
+        stack_end = vm_stack.data() + vm_stack.size(); \
+    }
+
+#define SYNC() \
+    vm_top = sp - vm_stack.data(); \
+    vm_fp = fp - vm_stack.data(); \
+    vm_code = code; \
+    vm_env = env
+
+// 二元原语：两个操作数都是 fixnum 时直接计算（溢出的结果提升为 bignum），否则交给对应的节点
+#define BINARY_FIXNUM(result) { \
+        Value v1 = sp[-1], v2 = sp[-2]; \
+        sp[-2] = (v1.bits & v2.bits & 1) ? (result) \
+            : static_cast<Binary*>(code->exprs[*pc].get())->evalRator(v1, v2); \
+        sp--; \
+        pc++; \
+    }
+
+
+/**
+ * @brief Value of a variable found unbound, as Var::eval defines it
+ */
+Value unboundVariable(Var *var, Assoc &env) {
+    if (var->x->primitive >= 0) {
+        return primitiveValue(var->x);
+    }
+    throw RuntimeError("undefined variable");
+}
+
+/**
+ * @brief Run vm_code in vm_env until it returns past the entry frame
+ */
+Value run() {
+    Code *code = vm_code;
+    Assoc env = vm_env;
+    const int32_t *pc = code->ops.data();
+    Value *sp = vm_stack.data() + vm_top;
+    Value *fp = sp + 1;     // 顶层代码没有过程，留出它的位置给返回值
+    Value *stack_end = vm_stack.data() + vm_stack.size();
+    bool tail;
+    ENSURE_STACK();
+    *sp++ = VoidV();
+
+#ifdef VM_COMPUTED_GOTO
+#define VM_LABEL(op) &&L_##op,
+    static void *const labels[OP_COUNT] = { BYTECODE_OPS(VM_LABEL) };
+#undef VM_LABEL
+#define TARGET(op) L_##op
+#define DISPATCH() goto *labels[*pc++]
+    DISPATCH();
+#else
+#define TARGET(op) case op
+#define DISPATCH() continue
+    for (;;) switch (*pc++) {
+#endif
+
+    TARGET(OP_FIXNUM): {
+        *sp++ = IntegerV(*pc++);
+        DISPATCH();
+    }
+    TARGET(OP_CONST): {
+        *sp++ = code->consts[*pc++];
+        DISPATCH();
+    }
+    TARGET(OP_STACK): {
+        Value v = fp[pc[0]];
+        // 未绑定时按 Var 节点的语义报错或构造原语过程
+        if (v.isUnbound()) v = unboundVariable(static_cast<Var*>(code->exprs[pc[1]].get()), env);
+        *sp++ = v;
+        pc += 2;
+        DISPATCH();
+    }
+    TARGET(OP_LOCAL0): {
+        Value v = env->slots()[pc[0]];
+        if (v.isUnbound()) v = unboundVariable(static_cast<Var*>(code->exprs[pc[1]].get()), env);
+        *sp++ = v;
+        pc += 2;
+        DISPATCH();
+    }
+    TARGET(OP_LOCAL1): {
+        Value v = env->parent->slots()[pc[0]];
+        if (v.isUnbound()) v = unboundVariable(static_cast<Var*>(code->exprs[pc[1]].get()), env);
+        *sp++ = v;
+        pc += 2;
+        DISPATCH();
+    }
+    TARGET(OP_LOCAL): {
+        Value v = bindingAt(pc[0], pc[1], env);
+        if (v.isUnbound()) v = unboundVariable(static_cast<Var*>(code->exprs[pc[2]].get()), env);
+        *sp++ = v;
+        pc += 3;
+        DISPATCH();
+    }
+    TARGET(OP_GLOBAL): {
+        Value v = code->cells[pc[0]]->v;
+        if (v.isUnbound()) v = unboundVariable(static_cast<Var*>(code->exprs[pc[1]].get()), env);
+        *sp++ = v;
+        pc += 2;
+        DISPATCH();
+    }
+    TARGET(OP_EVAL): {
+        SYNC();
+        Value v = code->exprs[*pc++]->eval(env);
+        *sp++ = v;
+        DISPATCH();
+    }
+    TARGET(OP_POP): {
+        sp--;
+        DISPATCH();
+    }
+    TARGET(OP_SWAP): {
+        std::swap(sp[-1], sp[-2]);
+        DISPATCH();
+    }
+    TARGET(OP_SLIDE): {
+        int32_t n = *pc++;
+        sp[-1 - n] = sp[-1];
+        sp -= n;
+        DISPATCH();
+    }
+    TARGET(OP_JUMP): {
+        int32_t off = *pc++;
+        pc += off;
+        DISPATCH();
+    }
+    TARGET(OP_JFALSE): {
+        int32_t off = *pc++;
+        if ((--sp)->bits == IMM_FALSE) pc += off;
+        DISPATCH();
+    }
+    TARGET(OP_JFALSE_KEEP): {
+        int32_t off = *pc++;
+        if (sp[-1].bits == IMM_FALSE) {
+            pc += off;
+        } else {
+            sp--;
+        }
+        DISPATCH();
+    }
+    TARGET(OP_JTRUE_KEEP): {
+        int32_t off = *pc++;
+        if (sp[-1].bits != IMM_FALSE) {
+            pc += off;
+        } else {
+            sp--;
+        }
+        DISPATCH();
+    }
+    TARGET(OP_CLOSURE): {
+        Lambda *lambda = static_cast<Lambda*>(code->exprs[pc[0]].get());
+        Value proc = ProcedureV(lambda->x, lambda->e, env);
+        static_cast<Procedure*>(proc.get())->code = code->codes[pc[1]];
+        *sp++ = proc;
+        pc += 2;
+        DISPATCH();
+    }
+    TARGET(OP_PUSH_FRAME): {
+        env = extend(*pc++, env);
+        DISPATCH();
+    }
+    TARGET(OP_BIND_FRAME): {
+        int32_t n = *pc++;
+        env = extend(n, env);
+        sp -= n;
+        std::copy(sp, sp + n, env->slots());
+        DISPATCH();
+    }
+    TARGET(OP_FILL_FRAME): {
+        int32_t n = *pc++;
+        sp -= n;
+        std::copy(sp, sp + n, env->slots());
+        DISPATCH();
+    }
+    TARGET(OP_POP_FRAME): {
+        env = env->parent;
+        DISPATCH();
+    }
+    TARGET(OP_PUSH_UNBOUND): {
+        int32_t n = *pc++;
+        std::fill(sp, sp + n, Value(nullptr));
+        sp += n;
+        DISPATCH();
+    }
+    TARGET(OP_FILL_STACK): {
+        int32_t n = pc[1];
+        sp -= n;
+        std::copy(sp, sp + n, fp + pc[0]);
+        pc += 2;
+        DISPATCH();
+    }
+    TARGET(OP_STORE_STACK): {
+        fp[*pc++] = sp[-1];
+        sp[-1] = VoidV();
+        DISPATCH();
+    }
+    TARGET(OP_STORE_LOCAL): {
+        bindingAt(pc[0], pc[1], env) = sp[-1];
+        sp[-1] = VoidV();
+        pc += 2;
+        DISPATCH();
+    }
+    TARGET(OP_STORE_GLOBAL): {
+        code->cells[*pc++]->v = sp[-1];
+        sp[-1] = VoidV();
+        DISPATCH();
+    }
+    TARGET(OP_SET_CHECK_STACK): {
+        if (fp[pc[1]].isUnbound()) {
+            Set *set = static_cast<Set*>(code->exprs[pc[0]].get());
+            throw RuntimeError("Undefined variable in set!: " + set->var->name);
+        }
+        pc += 2;
+        DISPATCH();
+    }
+    TARGET(OP_SET_CHECK): {
+        Set *set = static_cast<Set*>(code->exprs[pc[0]].get());
+        Value &slot = pc[1] >= 0 ? bindingAt(pc[1], pc[2], env) : set->global->v;
+        if (slot.isUnbound()) {
+            throw RuntimeError("Undefined variable in set!: " + set->var->name);
+        }
+        pc += 3;
+        DISPATCH();
+    }
+    TARGET(OP_CHECK_PROC): {
+        ValueType type = sp[-1].type();
+        if (type != V_PROC && type != V_PRIMITIVE) throw RuntimeError("Attempt to apply a non-procedure");
+        DISPATCH();
+    }
+    TARGET(OP_CALL):
+        tail = false;
+        goto do_call;
+    TARGET(OP_TAIL_CALL):
+        tail = true;
+    do_call: {
+        int32_t n = *pc++;
+        Value *args = sp - n;
+        if (Primitive *prim = args[-1].as<Primitive>()) {
+            // 原语过程直接在栈上的实参上执行，结果替换过程所在的位置
+            args[-1] = prim->apply(args, n);
+            sp = args;
+            if (tail) goto do_return;
+            DISPATCH();
+        }
+        Procedure *proc = static_cast<Procedure*>(args[-1].get());
+        if (n != int32_t(proc->parameters.size())) {
+            throw RuntimeError("Wrong number of arguments");
+        }
+
+        // 过程调用是垃圾回收的安全点：过程和实参此时都在操作数栈上
+        SYNC();
+        gcSafepoint();
+
+        // 不是由虚拟机创建的过程在第一次调用时编译
+        if (proc->code == nullptr) {
+            proc->code = compileCode(proc->e, n);
+        }
+        if (tail) {
+            // 尾调用：过程和实参移到当前帧的位置，调用者的返回点保持不变
+            std::copy(args - 1, sp, fp - 1);
+            sp = fp + n;
+        } else {
+            if (vm_frames.size() >= max_eval_depth) throw RuntimeError("Recursion too deep");
+            vm_frames.push_back({code, pc, env, size_t(fp - vm_stack.data())});
+            fp = args;
+        }
+        code = proc->code;
+        env = proc->env;
+        // 非扁平的过程体在堆上的帧中访问实参；无参过程直接在闭包环境中执行
+        if (!code->flat) {
+            if (n > 0) {
+                env = extend(n, proc->env);
+                std::copy(fp, sp, env->slots());
+            }
+            sp = fp;
+        }
+        pc = code->ops.data();
+        ENSURE_STACK();
+        DISPATCH();
+    }
+    TARGET(OP_RETURN):
+    do_return: {
+        // 返回值放到调用者放置过程的位置
+        fp[-1] = sp[-1];
+        sp = fp;
+        CallFrame &frame = vm_frames.back();
+        code = frame.code;
+        pc = frame.pc;
+        env = frame.env;
+        fp = vm_stack.data() + frame.fp;
+        vm_frames.pop_back();
+        if (pc == nullptr) {
+            Value result = *--sp;
+            SYNC();
+            return result;
+        }
+        DISPATCH();
+    }
+    TARGET(OP_ADD): BINARY_FIXNUM(ExactIntegerV((long long)v1.fixnum() + v2.fixnum())); DISPATCH();
+    TARGET(OP_SUB): BINARY_FIXNUM(ExactIntegerV((long long)v1.fixnum() - v2.fixnum())); DISPATCH();
+    TARGET(OP_MUL): BINARY_FIXNUM(ExactIntegerV((long long)v1.fixnum() * v2.fixnum())); DISPATCH();
+    TARGET(OP_LT): BINARY_FIXNUM(BooleanV(v1.fixnum() < v2.fixnum())); DISPATCH();
+    TARGET(OP_LE): BINARY_FIXNUM(BooleanV(v1.fixnum() <= v2.fixnum())); DISPATCH();
+    TARGET(OP_NUM_EQ): BINARY_FIXNUM(BooleanV(v1.fixnum() == v2.fixnum())); DISPATCH();
+    TARGET(OP_GE): BINARY_FIXNUM(BooleanV(v1.fixnum() >= v2.fixnum())); DISPATCH();
+    TARGET(OP_GT): BINARY_FIXNUM(BooleanV(v1.fixnum() > v2.fixnum())); DISPATCH();
+    TARGET(OP_EQQ): {
+        Value v1 = sp[-1], v2 = sp[-2];
+        sp[-2] = v1 == v2 ? BooleanV(true)
+            : static_cast<Binary*>(code->exprs[*pc].get())->evalRator(v1, v2);
+        sp--;
+        pc++;
+        DISPATCH();
+    }
+    TARGET(OP_CONS): {
+        sp[-2] = PairV(sp[-1], sp[-2]);
+        sp--;
+        pc++;
+        DISPATCH();
+    }
+    TARGET(OP_BINARY): {
+        sp[-2] = static_cast<Binary*>(code->exprs[*pc++].get())->evalRator(sp[-1], sp[-2]);
+        sp--;
+        DISPATCH();
+    }
+    TARGET(OP_CAR): {
+        Value v = sp[-1];
+        Pair *pair = v.as<Pair>();
+        sp[-1] = pair != nullptr ? pair->car
+            : static_cast<Unary*>(code->exprs[*pc].get())->evalRator(v);
+        pc++;
+        DISPATCH();
+    }
+    TARGET(OP_CDR): {
+        Value v = sp[-1];
+        Pair *pair = v.as<Pair>();
+        sp[-1] = pair != nullptr ? pair->cdr
+            : static_cast<Unary*>(code->exprs[*pc].get())->evalRator(v);
+        pc++;
+        DISPATCH();
+    }
+    TARGET(OP_NULLQ): {
+        sp[-1] = BooleanV(sp[-1].bits == IMM_NULL);
+        pc++;
+        DISPATCH();
+    }
+    TARGET(OP_PAIRQ): {
+        sp[-1] = BooleanV(sp[-1].as<Pair>() != nullptr);
+        pc++;
+        DISPATCH();
+    }
+    TARGET(OP_NOT): {
+        sp[-1] = BooleanV(sp[-1].bits == IMM_FALSE);
+        pc++;
+        DISPATCH();
+    }
+    TARGET(OP_UNARY): {
+        sp[-1] = static_cast<Unary*>(code->exprs[*pc++].get())->evalRator(sp[-1]);
+        DISPATCH();
+    }
+    TARGET(OP_VARIADIC): {
+        Variadic *node = static_cast<Variadic*>(code->exprs[pc[0]].get());
+        int32_t n = pc[1];
+        std::vector<Value> args(sp - n, sp);
+        Value result = node->evalRator(args);
+        sp -= n;
+        *sp++ = result;
+        pc += 2;
+        DISPATCH();
+    }
+
+#ifndef VM_COMPUTED_GOTO
+    default:
+        throw RuntimeError("Invalid opcode");
+    }
+#endif
+}
+
+#undef TARGET
+#undef DISPATCH
+
+} // namespace
+
+Value vmEval(const Expr &e, Assoc &env) {
+    GCRoot root(&markVM, nullptr);
+    size_t entry_top = vm_top;
+    size_t entry_frames = vm_frames.size();
+
+    // 入口帧保存外层的寄存器，返回到它时 run 结束
+    vm_frames.push_back({vm_code, nullptr, vm_env, vm_fp});
+    vm_code = compileCode(e, 0);
+    vm_env = env;
+    try {
+        return run();
+    } catch (...) {
+        // 出错时丢弃本次求值留下的栈帧和操作数
+        vm_code = vm_frames[entry_frames].code;
+        vm_env = vm_frames[entry_frames].env;
+        vm_fp = vm_frames[entry_frames].fp;
+        vm_frames.erase(vm_frames.begin() + entry_frames, vm_frames.end());
+        vm_top = entry_top;
+        throw;
+    }
+}
@@ -0,0 +1,70 @@
+/**
+ * @file writer.cpp
+ * @brief Buffered output sink shared by every printer
+ */
+
+#include "writer.hpp"
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+
+Writer output(STDOUT_FILENO);
+
+namespace {
+
+void writeAll(int fd, const char *p, size_t n) {
+    while (n > 0) {
+        ssize_t w = ::write(fd, p, n);
+        if (w < 0) {
+            if (errno == EINTR) continue;
+            return;     // 输出端已关闭，丢弃剩余内容
+        }
+        p += w;
+        n -= w;
+    }
+}
+
+} // namespace
+
+Writer::Writer(int fd) : fd(fd), len(0) {}
+
+Writer::~Writer() {
+    flush();
+}
+
+void Writer::flush() {
+    writeAll(fd, buf, len);
+    len = 0;
+}
+
+void Writer::write(const char *s, size_t n) {
+    if (n > SIZE - len) {
+        flush();
+        // 比缓冲区还大的内容不经过缓冲区直接写出
+        if (n >= SIZE) {
+            writeAll(fd, s, n);
+            return;
+        }
+    }
+    memcpy(buf + len, s, n);
+    len += n;
+}
+
+Writer &Writer::operator<<(const char *s) {
+    write(s, strlen(s));
+    return *this;
+}
+
+Writer &Writer::operator<<(long long n) {
+    // 从低位向高位填入临时缓冲区，负数按无符号取绝对值以容纳 LLONG_MIN
+    char digits[24];
+    char *p = digits + sizeof(digits);
+    unsigned long long m = n < 0 ? 0 - (unsigned long long)n : n;
+    do {
+        *--p = char('0' + m % 10);
+        m /= 10;
+    } while (m != 0);
+    if (n < 0) *--p = '-';
+    write(p, digits + sizeof(digits) - p);
+    return *this;
+}
@@ -0,0 +1,51 @@
+#ifndef WRITER_HPP
+#define WRITER_HPP
+
+/**
+ * @file writer.hpp
+ * @brief Buffered output sink shared by every printer
+ *
+ * All program output goes through one buffer that is written to the file
+ * descriptor with write(2) only when it fills up, before the reader waits
+ * for interactive input, and when the program ends. Integers are formatted
+ * by hand, without the locale machinery of iostreams.
+ */
+
+#include <cstddef>
+#include <string>
+
+class Writer {
+public:
+    explicit Writer(int fd);
+    ~Writer();                  ///< Flushes what is left
+
+    void write(const char *, size_t);
+    void flush();
+
+    Writer &operator<<(char c) {
+        if (len == SIZE) flush();
+        buf[len++] = c;
+        return *this;
+    }
+    Writer &operator<<(const char *);
+    Writer &operator<<(const std::string &s) {
+        write(s.data(), s.size());
+        return *this;
+    }
+    Writer &operator<<(long long);
+    Writer &operator<<(int n) {
+        return *this << (long long)n;
+    }
+
+private:
+    static const size_t SIZE = 1 << 16;
+    int fd;
+    size_t len;                 ///< Bytes waiting in buf
+    char buf[SIZE];
+    Writer(const Writer &);
+    Writer &operator=(const Writer &);
+};
+
+extern Writer output;           ///< Standard output
+
+#endif // WRITER_HPP
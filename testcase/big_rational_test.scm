@@ -0,0 +1,35 @@
+;; 有理数：分子分母超出 64 位时离开快速路径改用 BigInt，结果总是最简分数
+(define (sum-fractions n acc)
+  (if (= n 0)
+      acc
+      (sum-fractions (- n 1) (+ acc (/ (if (= (modulo n 2) 0) 1 -1) n)))))
+(sum-fractions 10 0)
+(sum-fractions 40 0)
+(sum-fractions 60 0)
+(define (product-fractions n acc)
+  (if (= n 1)
+      acc
+      (product-fractions (- n 1) (* acc (/ (- 0 n) (+ n 1))))))
+(product-fractions 30 1)
+(define (harmonic n acc)
+  (if (= n 0) acc (harmonic (- n 1) (+ acc (/ 1 n)))))
+(harmonic 50 0)
+(- (harmonic 50 0) (harmonic 49 0))
+(* (/ 4294967295 4294967296) (/ 4294967296 4294967295))
+(* (/ 9223372036854775807 2) (/ 2 9223372036854775807))
+(+ (/ 9223372036854775807 9223372036854775806) (/ -1 9223372036854775806))
+(+ (/ 1 18446744073709551616) (/ -1 18446744073709551617))
+(* (/ -123456789012345678901 98765432109876543210) (/ 98765432109876543210 -3))
+(/ (/ 100000000000000000000 3) (/ -200000000000000000000 9))
+(- (/ 1 3) (/ 1 3))
+(+ (/ 1 2) (/ 1 2))
+
+;; 大有理数的比较
+(< (/ 1 18446744073709551616) (/ 1 18446744073709551615))
+(> (/ -1 18446744073709551616) (/ -1 18446744073709551615))
+(= (/ 36893488147419103232 18446744073709551616) 2)
+(< (/ 100000000000000000001 100000000000000000000) (/ 100000000000000000000 99999999999999999999))
+(= (/ 6 100000000000000000000) (/ 3 50000000000000000000))
+(< (harmonic 30 0) (harmonic 31 0) 4)
+(> (/ -7 3) (/ -7000000000000000000001 3000000000000000000000))
+(exit)
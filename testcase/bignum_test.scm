@@ -0,0 +1,54 @@
+;; 精确整数：fixnum 边界上的溢出升级为 bignum，结果回到 fixnum 范围时降级
+(- -2147483648)
+(- 0 -2147483648)
+(+ 2147483647 1)
+(- -2147483648 1)
+(* 65536 32768)
+(* -65536 32768)
+(* 46341 46341)
+(quotient -2147483648 -1)
+(modulo -2147483648 -1)
+(quotient -2147483648 1)
+(- (+ 2147483647 1) 1)
+(+ 2147483648 -2147483648)
+(quotient 4294967296 2)
+(* 4294967296 4294967296)
+(- (* 4294967296 4294967296) 1)
+(number? 2147483648)
+(= 2147483648 (+ 2147483647 1))
+(< 2147483647 2147483648)
+(> -2147483649 -2147483648)
+
+;; bignum 的 quotient 与 modulo：商向零截断，modulo 与除数同号
+(quotient 100000000000000000000 7)
+(quotient -100000000000000000000 7)
+(quotient 100000000000000000000 -7)
+(quotient -100000000000000000000 -7)
+(modulo 100000000000000000000 7)
+(modulo -100000000000000000000 7)
+(modulo 100000000000000000000 -7)
+(modulo -100000000000000000000 -7)
+(quotient 7 100000000000000000000)
+(modulo 7 -100000000000000000000)
+(modulo -7 100000000000000000000)
+(modulo 200000000000000000000 100000000000000000000)
+
+;; 多个 limb 的除法
+(quotient 123456789012345678901234567890123456789 987654321987654321)
+(modulo 123456789012345678901234567890123456789 987654321987654321)
+(quotient -123456789012345678901234567890123456789 987654321987654321)
+(modulo -123456789012345678901234567890123456789 987654321987654321)
+(quotient (expt 2 200) (+ (expt 2 70) 3))
+(modulo (expt 2 200) (+ (expt 2 70) 3))
+(quotient (- (expt 2 128) 1) (- (expt 2 64) 1))
+(modulo (- (expt 2 128) 1) (- (expt 2 64) 1))
+(quotient (expt 10 60) (- (expt 2 96) 1))
+(modulo (- (expt 10 60)) (- (expt 2 96) 1))
+(quotient (* (+ (expt 2 95) 1) (+ (expt 2 95) 7)) (+ (expt 2 95) 7))
+(modulo (* (+ (expt 2 95) 1) (+ (expt 2 95) 7)) (+ (expt 2 95) 7))
+(define (check a b) (= a (+ (* (quotient a b) b) (- a (* (quotient a b) b)))))
+(check (expt 3 150) (- (expt 2 100) 1))
+(* 123456789012345678901234567890 -987654321098765432109876543210)
+(- (expt 2 64) (expt 2 64))
+(expt -3 41)
+(exit)
@@ -0,0 +1,29 @@
+;; 表的输出：环用数据标签表示，长表和深层嵌套的表不占用递归栈
+(define p (list 1 2 3))
+(set-cdr! (cdr (cdr p)) p)
+p
+(define q (list 1 2))
+(set-car! q q)
+q
+(define r (cons 1 2))
+(set-car! r r)
+(set-cdr! r r)
+r
+(define s (list 1 2))
+(define t (list s s 3))
+t
+(set-cdr! (cdr s) s)
+t
+(display p)
+(define (build n acc)
+  (if (= n 0) acc (build (- n 1) (cons n acc))))
+(define (nest n acc)
+  (if (= n 0) acc (nest (- n 1) (cons acc (quote ())))))
+(define (nest-cdr n acc)
+  (if (= n 0) acc (nest-cdr (- n 1) (list 0 acc))))
+(define long (build 1000000 (quote ())))
+(car long)
+long
+(nest 1000000 (quote ()))
+(nest-cdr 100000 1)
+(exit)
@@ -0,0 +1,38 @@
+;; 浮点数的读入与输出：最短的可往返表示，特殊值和精确/非精确转换
+1.
+1.5
+-2.25
+.5
+1e21
+1e20
+1.5e-7
+123456789012345678901234.
++inf.0
+-inf.0
++nan.0
+-0.0
+0.0
+(+ 0.1 0.2)
+(* 1.1 1.1)
+(/ 1. 3)
+(/ 1 3.)
+(- 0.0)
+(* -1 0.0)
+(/ 1 0.)
+(/ -1 0.)
+(- +inf.0 +inf.0)
+(exact->inexact (/ 1 3))
+(exact->inexact (expt 10 30))
+(inexact->exact 0.1)
+(inexact->exact 0.5)
+(inexact->exact -2.)
+(inexact->exact 1e20)
+(inexact->exact +inf.0)
+(inexact->exact -inf.0)
+(inexact->exact +nan.0)
+(= 0.1 (inexact->exact 0.1))
+(= 1 1.)
+(< 1 1.5 2)
+(= +nan.0 +nan.0)
+(= 0.0 -0.0)
+(exit)
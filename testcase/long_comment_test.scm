@@ -0,0 +1,2003 @@
+;; 跨过 64K 读缓冲区边界的注释：通过管道输入时，注释的后半段不能被当成代码
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+; comment with (display "BUG") (car 5)
+(display "ok")
+(exit)